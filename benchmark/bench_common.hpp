@@ -0,0 +1,101 @@
+/**
+ * @file bench_common.hpp
+ * @brief registration helpers shared by the benchmarks of qulacs_bench
+ */
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "internal/general/type.hpp"
+#include "state_vector.hpp"
+
+/**
+ * Range of the benchmarks, given by the command line of qulacs_bench.
+ */
+struct BenchConfig {
+    UINT min_qubit_count = 10;
+    UINT max_qubit_count = 30;
+    UINT qubit_count_step = 2;
+    std::vector<UINT> thread_count_list;
+};
+
+/**
+ * Bandwidth of the STREAM triad kernel in bytes per second, measured once
+ * by qulacs_bench before the benchmarks run.
+ */
+extern double stream_bandwidth;
+
+/**
+ * Set the number of threads used by the kernels.
+ */
+void set_thread_count(UINT thread_count);
+
+/**
+ * Report <code>bytes</code> moved per iteration as bytes_per_second, GB/s
+ * and the ratio to the STREAM bandwidth. The bytes are the least traffic
+ * the kernel needs, so a ratio close to 1 means it is bandwidth-bound.
+ */
+inline void report_bytes(benchmark::State& st, double bytes) {
+    const double total = bytes * st.iterations();
+    st.SetBytesProcessed((int64_t)total);
+    st.counters["GB/s"] =
+        benchmark::Counter(total / 1e9, benchmark::Counter::kIsRate);
+    st.counters["stream_ratio"] = benchmark::Counter(
+        total / stream_bandwidth, benchmark::Counter::kIsRate);
+}
+
+/**
+ * Register <code>body(st, qubit_count)</code> for every qubit count and
+ * thread count of <code>config</code>.
+ */
+template <typename F>
+void register_benchmark(
+    const std::string& name, const BenchConfig& config, F body) {
+    benchmark::internal::Benchmark* bench = benchmark::RegisterBenchmark(
+        name.c_str(), [body](benchmark::State& st) {
+            set_thread_count((UINT)st.range(1));
+            body(st, (UINT)st.range(0));
+        });
+    bench->ArgNames({"qubit", "thread"})
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+    for (UINT qubit_count = config.min_qubit_count;
+         qubit_count <= config.max_qubit_count;
+         qubit_count += config.qubit_count_step) {
+        for (UINT thread_count : config.thread_count_list) {
+            bench->Args({qubit_count, thread_count});
+        }
+    }
+}
+
+template <StateVectorImplementation IMPL>
+using ImplTag = std::integral_constant<StateVectorImplementation, IMPL>;
+
+/**
+ * Register <code>body(impl, st, qubit_count)</code> for double and single
+ * precision, where <code>decltype(impl)::value</code> is the
+ * StateVectorImplementation.
+ */
+template <typename F>
+void register_each_precision(
+    const std::string& name, const BenchConfig& config, F body) {
+    register_benchmark("double/" + name, config,
+        [body](benchmark::State& st, UINT qubit_count) {
+            body(ImplTag<StateVectorImplementation::DEFAULT>(), st,
+                qubit_count);
+        });
+    register_benchmark("float/" + name, config,
+        [body](benchmark::State& st, UINT qubit_count) {
+            body(ImplTag<StateVectorImplementation::DEFAULT_F32>(), st,
+                qubit_count);
+        });
+}
+
+void register_update_benchmarks(const BenchConfig& config);
+void register_stat_benchmarks(const BenchConfig& config);
+void register_state_benchmarks(const BenchConfig& config);
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include "internal/general/omp_util.hpp"
+#endif
+#include "bench_common.hpp"
+
+double stream_bandwidth = 1.;
+
+void set_thread_count(UINT thread_count) {
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_thread_max(thread_count);
+    omp_set_num_threads(thread_count);
+#else
+    (void)thread_count;
+#endif
+}
+
+// Best of several runs of the STREAM triad a = b + s * c on arrays much
+// larger than the last level cache, counting 3 * 8 bytes per element.
+static double measure_stream_bandwidth() {
+    const ITYPE size = (ITYPE)1 << 25;
+    std::vector<double> a(size), b(size), c(size);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (ITYPE i = 0; i < size; ++i) {
+        a[i] = 0.;
+        b[i] = 1.;
+        c[i] = 2.;
+    }
+    double best = 0.;
+    for (int trial = 0; trial < 5; ++trial) {
+        const auto start = std::chrono::steady_clock::now();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (ITYPE i = 0; i < size; ++i) {
+            a[i] = b[i] + 3. * c[i];
+        }
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        best = std::max(best, 3. * sizeof(double) * size / elapsed.count());
+    }
+    benchmark::DoNotOptimize(a.data());
+    return best;
+}
+
+// Take "--name=value" out of argv.
+static bool parse_flag(const char* arg, const char* name, UINT& value) {
+    const size_t length = std::strlen(name);
+    if (std::strncmp(arg, name, length) != 0 || arg[length] != '=') {
+        return false;
+    }
+    value = (UINT)std::strtoul(arg + length + 1, nullptr, 0);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    BenchConfig config;
+    UINT max_thread_count = 1;
+#ifdef _OPENMP
+    max_thread_count = omp_get_max_threads();
+#endif
+    int rest = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (parse_flag(argv[i], "--min_qubit", config.min_qubit_count) ||
+            parse_flag(argv[i], "--max_qubit", config.max_qubit_count) ||
+            parse_flag(argv[i], "--qubit_step", config.qubit_count_step) ||
+            parse_flag(argv[i], "--max_thread", max_thread_count)) {
+            continue;
+        }
+        argv[rest++] = argv[i];
+    }
+    argc = rest;
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+#ifndef _OPENMP
+    if (max_thread_count > 1) {
+        std::fprintf(stderr,
+            "qulacs_bench: --max_thread needs a build with -DUSE_OMP=ON\n");
+        return 1;
+    }
+#endif
+    config.qubit_count_step = std::max(config.qubit_count_step, 1U);
+    for (UINT thread_count = 1; thread_count < max_thread_count;
+         thread_count *= 2) {
+        config.thread_count_list.push_back(thread_count);
+    }
+    config.thread_count_list.push_back(std::max(max_thread_count, 1U));
+
+    set_thread_count(config.thread_count_list.back());
+    stream_bandwidth = measure_stream_bandwidth();
+    benchmark::AddCustomContext(
+        "stream_triad_GB/s", std::to_string(stream_bandwidth / 1e9));
+
+    register_update_benchmarks(config);
+    register_stat_benchmarks(config);
+    register_state_benchmarks(config);
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
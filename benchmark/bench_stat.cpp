@@ -0,0 +1,111 @@
+#include <string>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "observable.hpp"
+#include "sampler.hpp"
+
+// Reductions read the whole state once.
+template <StateVectorImplementation IMPL>
+static double read_bytes(const StateVector<IMPL>& state) {
+    return (double)state.dim *
+           sizeof(typename StateVector<IMPL>::value_type);
+}
+
+// Register a reduction; <code>fraction</code> is the part of the state it
+// has to read.
+template <typename F>
+static void register_reduction(const std::string& name,
+    const BenchConfig& config, double fraction, F compute) {
+    register_each_precision(name, config,
+        [compute, fraction](
+            auto impl, benchmark::State& st, UINT qubit_count) {
+            StateVector<decltype(impl)::value> state(qubit_count, false);
+            state.set_Haar_random_state(0);
+            for (auto _ : st) {
+                benchmark::DoNotOptimize(compute(state));
+            }
+            report_bytes(st, read_bytes(state) * fraction);
+        });
+}
+
+void register_stat_benchmarks(const BenchConfig& config) {
+    register_reduction("get_squared_norm", config, 1.,
+        [](const auto& state) { return state.get_squared_norm(); });
+    register_reduction("get_entropy", config, 1.,
+        [](const auto& state) { return state.get_entropy(); });
+    register_reduction("get_zero_probability/low", config, 1.,
+        [](const auto& state) { return state.get_zero_probability(0); });
+    register_reduction("get_zero_probability/high", config, 0.5,
+        [](const auto& state) {
+            return state.get_zero_probability(state.qubit_count - 1);
+        });
+    register_reduction("get_zero_probabilities", config, 1.,
+        [](const auto& state) { return state.get_zero_probabilities(); });
+    for (const UINT measured_count : {1U, 8U}) {
+        register_reduction(
+            "get_marginal_probability/" + std::to_string(measured_count),
+            config, 1. / (1ULL << measured_count),
+            [measured_count](const auto& state) {
+                // measure the highest qubits so the runs are the longest
+                std::vector<UINT> measured_values(state.qubit_count, 2);
+                for (UINT i = 0; i < measured_count; ++i) {
+                    measured_values[state.qubit_count - 1 - i] = i % 2;
+                }
+                return state.get_marginal_probability(measured_values);
+            });
+    }
+    register_reduction("get_marginal_distribution/4", config, 1.,
+        [](const auto& state) {
+            return state.get_marginal_distribution(
+                {0, 1, state.qubit_count - 2, state.qubit_count - 1});
+        });
+    register_reduction("get_statistics", config, 1., [](const auto& state) {
+        StatisticsRequest request;
+        request.entropy = true;
+        request.zero_probabilities = true;
+        request.marginal_list.push_back(
+            std::vector<UINT>(state.qubit_count, 2));
+        request.marginal_list.back()[0] = 1;
+        return state.get_statistics(request).squared_norm;
+    });
+    // the blocked sampler sweeps the state twice
+    register_reduction("sampling/1000", config, 2.,
+        [](const auto& state) { return state.sampling(1000, 0); });
+    register_reduction("Sampler/construct", config, 1.,
+        [](const auto& state) { return Sampler(state).sampling(1, 0); });
+    // the table is built once, so this times the binary searches alone
+    register_each_precision("Sampler/sampling/1000000", config,
+        [](auto impl, benchmark::State& st, UINT qubit_count) {
+            StateVector<decltype(impl)::value> state(qubit_count, false);
+            state.set_Haar_random_state(0);
+            const Sampler sampler(state);
+            const UINT sampling_count = 1000000;
+            for (auto _ : st) {
+                benchmark::DoNotOptimize(sampler.sampling(sampling_count, 0));
+            }
+            st.SetItemsProcessed((int64_t)sampling_count * st.iterations());
+        });
+
+    // an Ising-like Hamiltonian: Z_i Z_{i+1} and X_i on every qubit, i.e.
+    // one group for the Z terms and one group per X term
+    register_each_precision("Observable/get_expectation_value", config,
+        [](auto impl, benchmark::State& st, UINT qubit_count) {
+            StateVector<decltype(impl)::value> state(qubit_count, false);
+            state.set_Haar_random_state(0);
+            Observable observable(qubit_count);
+            for (UINT i = 0; i + 1 < qubit_count; ++i) {
+                observable.add_term(1., {i, i + 1}, {3, 3});
+            }
+            for (UINT i = 0; i < qubit_count; ++i) {
+                observable.add_term(0.5, {i}, {1});
+            }
+            for (auto _ : st) {
+                benchmark::DoNotOptimize(
+                    observable.get_expectation_value(state));
+            }
+            // each group reads the amplitude and its partner
+            report_bytes(
+                st, 2. * read_bytes(state) * observable.get_group_count());
+        });
+}
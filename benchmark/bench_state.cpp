@@ -0,0 +1,88 @@
+#include <vector>
+
+#include "bench_common.hpp"
+
+template <StateVectorImplementation IMPL>
+static double state_bytes(const StateVector<IMPL>& state) {
+    return (double)state.dim *
+           sizeof(typename StateVector<IMPL>::value_type);
+}
+
+void register_state_benchmarks(const BenchConfig& config) {
+    register_each_precision("set_zero_state", config,
+        [](auto impl, benchmark::State& st, UINT qubit_count) {
+            StateVector<decltype(impl)::value> state(qubit_count, false);
+            for (auto _ : st) {
+                state.set_zero_state();
+            }
+            report_bytes(st, state_bytes(state));
+        });
+    register_each_precision("set_Haar_random_state", config,
+        [](auto impl, benchmark::State& st, UINT qubit_count) {
+            StateVector<decltype(impl)::value> state(qubit_count, false);
+            for (auto _ : st) {
+                state.set_Haar_random_state(0);
+            }
+            report_bytes(st, state_bytes(state));
+        });
+    register_each_precision("inner_product", config,
+        [](auto impl, benchmark::State& st, UINT qubit_count) {
+            StateVector<decltype(impl)::value> bra(qubit_count, false),
+                ket(qubit_count, false);
+            bra.set_Haar_random_state(0);
+            ket.set_Haar_random_state(1);
+            for (auto _ : st) {
+                benchmark::DoNotOptimize(state::inner_product(bra, ket));
+            }
+            report_bytes(st, 2. * state_bytes(bra));
+        });
+    register_each_precision("make_superposition", config,
+        [](auto impl, benchmark::State& st, UINT qubit_count) {
+            StateVector<decltype(impl)::value> state1(qubit_count, false),
+                state2(qubit_count, false), state_out(qubit_count, false);
+            state1.set_Haar_random_state(0);
+            state2.set_Haar_random_state(1);
+            for (auto _ : st) {
+                state::make_superposition(
+                    0.6, state1, CTYPE(0., 0.8), state2, state_out);
+            }
+            report_bytes(st, 3. * state_bytes(state1));
+        });
+    register_each_precision("tensor_product", config,
+        [](auto impl, benchmark::State& st, UINT qubit_count) {
+            const UINT left_count = qubit_count / 2;
+            StateVector<decltype(impl)::value> left(left_count, false),
+                right(qubit_count - left_count, false),
+                state_out(qubit_count, false);
+            left.set_Haar_random_state(0);
+            right.set_Haar_random_state(1);
+            for (auto _ : st) {
+                state::tensor_product(left, right, state_out);
+            }
+            report_bytes(st, state_bytes(state_out));
+        });
+    register_each_precision("permutate_qubit/reverse", config,
+        [](auto impl, benchmark::State& st, UINT qubit_count) {
+            StateVector<decltype(impl)::value> state(qubit_count, false),
+                state_out(qubit_count, false);
+            state.set_Haar_random_state(0);
+            std::vector<UINT> qubit_order(qubit_count);
+            for (UINT i = 0; i < qubit_count; ++i) {
+                qubit_order[i] = qubit_count - 1 - i;
+            }
+            for (auto _ : st) {
+                state::permutate_qubit(state, qubit_order, state_out);
+            }
+            report_bytes(st, 2. * state_bytes(state));
+        });
+    register_each_precision("drop_qubit", config,
+        [](auto impl, benchmark::State& st, UINT qubit_count) {
+            StateVector<decltype(impl)::value> state(qubit_count, false),
+                state_out(qubit_count - 1, false);
+            state.set_Haar_random_state(0);
+            for (auto _ : st) {
+                state::drop_qubit(state, {qubit_count - 1}, {1}, state_out);
+            }
+            report_bytes(st, 2. * state_bytes(state_out));
+        });
+}
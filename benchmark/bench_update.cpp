@@ -0,0 +1,168 @@
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "circuit.hpp"
+#include "gate.hpp"
+
+// Every gate reads and writes the whole state once.
+template <StateVectorImplementation IMPL>
+static double sweep_bytes(const StateVector<IMPL>& state) {
+    return 2. * state.dim * sizeof(typename StateVector<IMPL>::value_type);
+}
+
+// Register a single qubit gate acting on the lowest and on the highest
+// qubit, which have the shortest and the longest strides.
+template <typename F>
+static void register_single_qubit(
+    const std::string& name, const BenchConfig& config, F apply) {
+    for (const bool high : {false, true}) {
+        register_each_precision(name + (high ? "/high" : "/low"), config,
+            [apply, high](auto impl, benchmark::State& st, UINT qubit_count) {
+                StateVector<decltype(impl)::value> state(qubit_count, false);
+                state.set_Haar_random_state(0);
+                const UINT target = high ? qubit_count - 1 : 0;
+                for (auto _ : st) {
+                    apply(state, target);
+                }
+                report_bytes(st, sweep_bytes(state));
+            });
+    }
+}
+
+void register_update_benchmarks(const BenchConfig& config) {
+    const CTYPE hadamard[4] = {
+        1. / std::sqrt(2.), 1. / std::sqrt(2.), 1. / std::sqrt(2.),
+        -1. / std::sqrt(2.)};
+    const CTYPE diagonal[2] = {CTYPE(0., 1.), CTYPE(0.6, 0.8)};
+
+    register_single_qubit("apply_X", config,
+        [](auto& state, UINT target) { state.apply_X(target); });
+    register_single_qubit("apply_Y", config,
+        [](auto& state, UINT target) { state.apply_Y(target); });
+    register_single_qubit("apply_Z", config,
+        [](auto& state, UINT target) { state.apply_Z(target); });
+    register_single_qubit("apply_S", config,
+        [](auto& state, UINT target) { state.apply_S(target); });
+    register_single_qubit("apply_Sdag", config,
+        [](auto& state, UINT target) { state.apply_Sdag(target); });
+    register_single_qubit("apply_T", config,
+        [](auto& state, UINT target) { state.apply_T(target); });
+    register_single_qubit("apply_Tdag", config,
+        [](auto& state, UINT target) { state.apply_Tdag(target); });
+    register_single_qubit("apply_P0", config,
+        [](auto& state, UINT target) { state.apply_P0(target); });
+    register_single_qubit("apply_P1", config,
+        [](auto& state, UINT target) { state.apply_P1(target); });
+    register_single_qubit("apply_RZ", config,
+        [](auto& state, UINT target) { state.apply_RZ(target, 0.3); });
+    register_single_qubit("apply_single_qubit_phase", config,
+        [](auto& state, UINT target) {
+            state.apply_single_qubit_phase(target, CTYPE(0.6, 0.8));
+        });
+    register_single_qubit("apply_single_qubit_diagonal_matrix", config,
+        [diagonal](auto& state, UINT target) {
+            state.apply_single_qubit_diagonal_matrix(target, diagonal);
+        });
+    register_single_qubit("apply_single_qubit_dense_matrix", config,
+        [hadamard](auto& state, UINT target) {
+            state.apply_single_qubit_dense_matrix(target, hadamard);
+        });
+
+    for (const UINT target_count : {2U, 3U, 4U}) {
+        register_each_precision(
+            "apply_multi_qubit_dense_matrix/" + std::to_string(target_count),
+            config,
+            [target_count](
+                auto impl, benchmark::State& st, UINT qubit_count) {
+                StateVector<decltype(impl)::value> state(qubit_count, false);
+                state.set_Haar_random_state(0);
+                std::vector<UINT> target_list;
+                for (UINT i = 0; i < target_count; ++i) {
+                    target_list.push_back(i * (qubit_count - 1) /
+                                          (target_count - 1));
+                }
+                const ITYPE matrix_dim = 1ULL << target_count;
+                std::vector<CTYPE> matrix(matrix_dim * matrix_dim);
+                for (ITYPE i = 0; i < matrix.size(); ++i) {
+                    matrix[i] = CTYPE(std::cos(i), std::sin(i));
+                }
+                for (auto _ : st) {
+                    state.apply_multi_qubit_dense_matrix(target_list, matrix);
+                }
+                report_bytes(st, sweep_bytes(state));
+            });
+    }
+    register_each_precision("apply_multi_qubit_dense_matrix/controlled",
+        config, [hadamard](auto impl, benchmark::State& st, UINT qubit_count) {
+            StateVector<decltype(impl)::value> state(qubit_count, false);
+            state.set_Haar_random_state(0);
+            const std::vector<CTYPE> matrix(hadamard, hadamard + 4);
+            for (auto _ : st) {
+                state.apply_multi_qubit_dense_matrix(
+                    {0}, matrix, {qubit_count - 1}, {1});
+            }
+            // only the half with the control bit set is touched
+            report_bytes(st, sweep_bytes(state) / 2);
+        });
+    register_each_precision("apply_SWAP", config,
+        [](auto impl, benchmark::State& st, UINT qubit_count) {
+            StateVector<decltype(impl)::value> state(qubit_count, false);
+            state.set_Haar_random_state(0);
+            for (auto _ : st) {
+                state.apply_SWAP(0, qubit_count - 1);
+            }
+            // only the amplitudes whose two bits differ are exchanged
+            report_bytes(st, sweep_bytes(state) / 2);
+        });
+    register_each_precision("normalize", config,
+        [](auto impl, benchmark::State& st, UINT qubit_count) {
+            StateVector<decltype(impl)::value> state(qubit_count, false);
+            state.set_Haar_random_state(0);
+            for (auto _ : st) {
+                state.normalize(1.);
+            }
+            report_bytes(st, sweep_bytes(state));
+        });
+    register_each_precision("apply_projection", config,
+        [](auto impl, benchmark::State& st, UINT qubit_count) {
+            StateVector<decltype(impl)::value> state(qubit_count, false);
+            for (auto _ : st) {
+                st.PauseTiming();
+                state.set_Haar_random_state(0);
+                st.ResumeTiming();
+                state.apply_projection({qubit_count - 1}, {0});
+            }
+            // the marginal probability reads half, the projection sweeps all
+            report_bytes(st, sweep_bytes(state) * 5 / 4);
+        });
+
+    // a layer of H on every qubit followed by a CNOT ladder
+    for (const bool blocked : {false, true}) {
+        register_each_precision(
+            blocked ? "Circuit/update_quantum_state_blocked"
+                    : "Circuit/update_quantum_state",
+            config,
+            [blocked](auto impl, benchmark::State& st, UINT qubit_count) {
+                StateVector<decltype(impl)::value> state(qubit_count, false);
+                state.set_Haar_random_state(0);
+                Circuit circuit(qubit_count);
+                for (UINT i = 0; i < qubit_count; ++i) {
+                    circuit.add_gate(gate::H(i));
+                }
+                for (UINT i = 0; i + 1 < qubit_count; ++i) {
+                    circuit.add_gate(gate::CNOT(i, i + 1));
+                }
+                for (auto _ : st) {
+                    if (blocked) {
+                        circuit.update_quantum_state_blocked(state);
+                    } else {
+                        circuit.update_quantum_state(state);
+                    }
+                }
+                report_bytes(st, sweep_bytes(state) *
+                                     circuit.get_gate_list().size());
+            });
+    }
+}
@@ -0,0 +1,299 @@
+#include "circuit.hpp"
+
+#include <algorithm>
+
+#include "internal/general/check_constraints.hpp"
+#ifdef _OPENMP
+#include "internal/general/omp_util.hpp"
+#endif
+
+constexpr StateVectorImplementation DEFAULT =
+    StateVectorImplementation::DEFAULT;
+constexpr StateVectorImplementation DEFAULT_F32 =
+    StateVectorImplementation::DEFAULT_F32;
+constexpr StateVectorImplementation MPI = StateVectorImplementation::MPI;
+
+Circuit::Circuit(UINT qubit_count_) : _qubit_count(qubit_count_) {}
+
+void Circuit::add_gate(const Gate& gate) {
+    std::vector<UINT> qubit_index_list = gate.get_qubit_index_list();
+    for (UINT qubit_index : qubit_index_list) {
+        check_out_of_range("qubit_index", qubit_index, 0U, this->_qubit_count);
+    }
+    check_no_duplicate("qubit_index_list", qubit_index_list);
+    this->_gate_list.push_back(gate);
+}
+
+template <StateVectorImplementation IMPL>
+void Circuit::update_quantum_state(StateVector<IMPL>& state) const {
+    check_equal("state.qubit_count", state.qubit_count, this->_qubit_count);
+    if constexpr (IMPL == MPI) {
+        update_quantum_state_relocated(state);
+        return;
+    }
+    for (const Gate& gate : this->_gate_list) {
+        gate.update_quantum_state(state);
+    }
+}
+
+#ifdef _USE_MPI
+/**
+ * Targets that a gate exchanges between ranks when they are outer. Diagonal
+ * gates and controls only select or scale the local amplitudes.
+ */
+static std::vector<UINT> get_exchanged_qubits(const Gate& gate) {
+    switch (gate.type) {
+        case GateType::X:
+        case GateType::Y:
+        case GateType::DenseMatrix:
+            return gate.target_qubit_index_list;
+        default:
+            return {};
+    }
+}
+
+void Circuit::update_quantum_state_relocated(StateVector<MPI>& state) const {
+    const UINT inner_qc = state.data.inner_qc;
+    const UINT gate_count = this->_gate_list.size();
+    std::vector<std::vector<UINT>> exchanged_list(gate_count);
+    // gates exchanging each qubit, in order
+    std::vector<std::vector<UINT>> use_list(this->_qubit_count);
+    for (UINT gate_index = 0; gate_index < gate_count; ++gate_index) {
+        exchanged_list[gate_index] =
+            get_exchanged_qubits(this->_gate_list[gate_index]);
+        for (UINT qubit_index : exchanged_list[gate_index]) {
+            use_list[qubit_index].push_back(gate_index);
+        }
+    }
+    auto get_next_use = [&](UINT qubit_index, UINT gate_index) {
+        const std::vector<UINT>& uses = use_list[qubit_index];
+        auto ite = std::upper_bound(uses.begin(), uses.end(), gate_index);
+        return ite == uses.end() ? gate_count : *ite;
+    };
+
+    for (UINT gate_index = 0; gate_index < gate_count; ++gate_index) {
+        const std::vector<UINT>& exchanged = exchanged_list[gate_index];
+        std::vector<UINT> qubit_map = state.data.qubit_map;
+        std::vector<UINT> stored_qubit(this->_qubit_count);
+        for (UINT i = 0; i < this->_qubit_count; ++i) {
+            stored_qubit[qubit_map[i]] = i;
+        }
+        auto is_exchanged = [&](UINT qubit_index) {
+            return std::find(exchanged.begin(), exchanged.end(),
+                       qubit_index) != exchanged.end();
+        };
+        for (UINT qubit_index : exchanged) {
+            if (qubit_map[qubit_index] < inner_qc) continue;
+            // evict the inner qubit exchanged furthest in the future. ties go
+            // to the highest position like the swaps inside the gate kernels
+            UINT victim = inner_qc, victim_next_use = 0;
+            for (UINT position = inner_qc; position-- > 0;) {
+                const UINT candidate = stored_qubit[position];
+                if (is_exchanged(candidate)) continue;
+                const UINT next_use = get_next_use(candidate, gate_index);
+                if (victim == inner_qc || next_use > victim_next_use) {
+                    victim = position;
+                    victim_next_use = next_use;
+                }
+            }
+            // too few inner qubits. the gate kernel swaps by itself or throws
+            if (victim == inner_qc) break;
+            const UINT victim_qubit = stored_qubit[victim];
+            const UINT outer_position = qubit_map[qubit_index];
+            qubit_map[victim_qubit] = outer_position;
+            stored_qubit[outer_position] = victim_qubit;
+            qubit_map[qubit_index] = victim;
+            stored_qubit[victim] = qubit_index;
+        }
+        if (qubit_map != state.data.qubit_map) state.set_qubit_map(qubit_map);
+        this->_gate_list[gate_index].update_quantum_state(state);
+    }
+}
+#endif
+
+template void Circuit::update_quantum_state(StateVector<DEFAULT>& state) const;
+template void Circuit::update_quantum_state(
+    StateVector<DEFAULT_F32>& state) const;
+#ifdef _USE_MPI
+template void Circuit::update_quantum_state(StateVector<MPI>& state) const;
+#endif
+
+template <StateVectorImplementation IMPL>
+void Circuit::update_quantum_state_blocked(
+    StateVector<IMPL>& state, UINT block_qubit_count) const {
+    check_equal("state.qubit_count", state.qubit_count, this->_qubit_count);
+    if constexpr (IMPL != DEFAULT && IMPL != DEFAULT_F32) {
+        // slabs of MPI are not split into blocks
+        update_quantum_state(state);
+        return;
+    } else {
+        if (block_qubit_count >= this->_qubit_count) {
+            update_quantum_state(state);
+            return;
+        }
+        auto is_local = [&](const Gate& gate) {
+            for (UINT qubit_index : gate.get_qubit_index_list()) {
+                if (qubit_index >= block_qubit_count) return false;
+            }
+            return true;
+        };
+
+        const UINT gate_count = this->_gate_list.size();
+        UINT begin = 0;
+        while (begin < gate_count) {
+            UINT end = begin;
+            while (end < gate_count && is_local(this->_gate_list[end])) ++end;
+            if (end - begin <= 1) {
+                // nothing to share a sweep with
+                this->_gate_list[begin].update_quantum_state(state);
+                ++begin;
+                continue;
+            }
+
+            const ITYPE block_dim = 1ULL << block_qubit_count;
+            const ITYPE block_count = state.dim >> block_qubit_count;
+            using value_type = typename StateVector<IMPL>::value_type;
+            value_type* data = state._data.data.data();
+#ifdef _OPENMP
+            OMPutil::get_inst().set_qulacs_num_threads(state.dim, 13);
+#pragma omp parallel
+#endif
+            {
+                // gate kernels called here run single-threaded since
+                // OMPutil gives one thread inside an active parallel region
+                StateVector<IMPL> block_state(block_qubit_count, false);
+                value_type* block = block_state._data.data.data();
+#ifdef _OPENMP
+#pragma omp for
+#endif
+                for (ITYPE block_index = 0; block_index < block_count;
+                     ++block_index) {
+                    value_type* first = data + block_index * block_dim;
+                    std::copy(first, first + block_dim, block);
+                    for (UINT i = begin; i < end; ++i) {
+                        this->_gate_list[i].update_quantum_state(block_state);
+                    }
+                    std::copy(block, block + block_dim, first);
+                }
+            }
+#ifdef _OPENMP
+            OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+            begin = end;
+        }
+    }
+}
+
+template void Circuit::update_quantum_state_blocked(
+    StateVector<DEFAULT>& state, UINT block_qubit_count) const;
+template void Circuit::update_quantum_state_blocked(
+    StateVector<DEFAULT_F32>& state, UINT block_qubit_count) const;
+#ifdef _USE_MPI
+template void Circuit::update_quantum_state_blocked(
+    StateVector<MPI>& state, UINT block_qubit_count) const;
+#endif
+
+/**
+ * Expand matrix on <code>from_qubit_index_list</code> to the matrix on
+ * <code>to_qubit_index_list</code>, which must include all of the former.
+ */
+static std::vector<CTYPE> expand_matrix(const std::vector<CTYPE>& matrix,
+    const std::vector<UINT>& from_qubit_index_list,
+    const std::vector<UINT>& to_qubit_index_list) {
+    const ITYPE from_dim = 1ULL << from_qubit_index_list.size();
+    const ITYPE to_dim = 1ULL << to_qubit_index_list.size();
+    std::vector<UINT> position_list(from_qubit_index_list.size());
+    ITYPE from_mask = 0;
+    for (UINT i = 0; i < from_qubit_index_list.size(); ++i) {
+        position_list[i] = std::find(to_qubit_index_list.begin(),
+                               to_qubit_index_list.end(),
+                               from_qubit_index_list[i]) -
+                           to_qubit_index_list.begin();
+        from_mask |= 1ULL << position_list[i];
+    }
+    auto extract = [&](ITYPE index) {
+        ITYPE result = 0;
+        for (UINT i = 0; i < position_list.size(); ++i) {
+            result |= ((index >> position_list[i]) & 1) << i;
+        }
+        return result;
+    };
+    std::vector<CTYPE> expanded(to_dim * to_dim, 0.);
+    for (ITYPE y = 0; y < to_dim; ++y) {
+        for (ITYPE x = 0; x < to_dim; ++x) {
+            if ((y & ~from_mask) != (x & ~from_mask)) continue;
+            expanded[y * to_dim + x] =
+                matrix[extract(y) * from_dim + extract(x)];
+        }
+    }
+    return expanded;
+}
+
+static std::vector<CTYPE> multiply_matrix(
+    const std::vector<CTYPE>& lhs, const std::vector<CTYPE>& rhs, ITYPE dim) {
+    std::vector<CTYPE> result(dim * dim, 0.);
+    for (ITYPE y = 0; y < dim; ++y) {
+        for (ITYPE k = 0; k < dim; ++k) {
+            CTYPE lhs_val = lhs[y * dim + k];
+            if (lhs_val == 0.) continue;
+            for (ITYPE x = 0; x < dim; ++x) {
+                result[y * dim + x] += lhs_val * rhs[k * dim + x];
+            }
+        }
+    }
+    return result;
+}
+
+void Circuit::fuse_gates(UINT max_block_qubit_count) {
+    check_out_of_range("max_block_qubit_count", max_block_qubit_count, 1U,
+        this->_qubit_count + 1);
+    std::vector<Gate> fused_gate_list;
+    std::vector<Gate> block_gate_list;
+    std::vector<UINT> block_qubit_index_list;
+    std::vector<CTYPE> block_matrix;
+
+    auto flush = [&]() {
+        if (block_gate_list.size() == 1) {
+            fused_gate_list.push_back(block_gate_list[0]);
+        } else if (block_gate_list.size() > 1) {
+            fused_gate_list.push_back(
+                gate::DenseMatrix(block_qubit_index_list, block_matrix));
+        }
+        block_gate_list.clear();
+        block_qubit_index_list.clear();
+        block_matrix.clear();
+    };
+
+    for (const Gate& gate : this->_gate_list) {
+        std::vector<UINT> gate_qubit_index_list = gate.get_qubit_index_list();
+        std::vector<UINT> merged_qubit_index_list = block_qubit_index_list;
+        for (UINT qubit_index : gate_qubit_index_list) {
+            if (std::find(merged_qubit_index_list.begin(),
+                    merged_qubit_index_list.end(),
+                    qubit_index) == merged_qubit_index_list.end()) {
+                merged_qubit_index_list.push_back(qubit_index);
+            }
+        }
+        if (!block_gate_list.empty() &&
+            merged_qubit_index_list.size() > max_block_qubit_count) {
+            flush();
+            merged_qubit_index_list = gate_qubit_index_list;
+        }
+
+        if (block_gate_list.empty()) {
+            block_matrix = gate.get_matrix();
+        } else {
+            const ITYPE merged_dim = 1ULL << merged_qubit_index_list.size();
+            block_matrix = multiply_matrix(
+                expand_matrix(gate.get_matrix(), gate_qubit_index_list,
+                    merged_qubit_index_list),
+                expand_matrix(block_matrix, block_qubit_index_list,
+                    merged_qubit_index_list),
+                merged_dim);
+        }
+        block_qubit_index_list = merged_qubit_index_list;
+        block_gate_list.push_back(gate);
+    }
+    flush();
+    this->_gate_list = fused_gate_list;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file circuit.hpp
+ * @brief Circuit class definition
+ */
+
+#pragma once
+#include <vector>
+
+#include "gate.hpp"
+#include "internal/general/type.hpp"
+#include "state_vector.hpp"
+
+/**
+ * @brief sequence of gates
+ * \~japanese-en 量子回路 (ゲートの列)
+ */
+class Circuit {
+private:
+    UINT _qubit_count;
+    std::vector<Gate> _gate_list;
+
+    /**
+     * apply gates to a distributed state, relocating outer qubits that the
+     * next gate exchanges between ranks to inner positions beforehand
+     */
+    void update_quantum_state_relocated(
+        StateVector<StateVectorImplementation::MPI>& state) const;
+
+public:
+    /**
+     * @brief constructor
+     * \~japanese-en コンストラクタ
+     * @param qubit_count num of qubits
+     */
+    Circuit(UINT qubit_count_);
+
+    /**
+     * @brief num of qubits
+     * \~japanese-en 量子ビット数
+     */
+    UINT get_qubit_count() const { return _qubit_count; }
+
+    /**
+     * @brief list of gates
+     * \~japanese-en ゲートのリスト
+     */
+    const std::vector<Gate>& get_gate_list() const { return _gate_list; }
+
+    /**
+     * @brief add gate to the end of circuit
+     * \~japanese-en 回路の末尾にゲートを追加する
+     *
+     * @param gate 追加するゲート
+     */
+    void add_gate(const Gate& gate);
+
+    /**
+     * @brief apply all gates to state in order
+     * \~japanese-en 量子状態に回路のゲートを順に作用させる
+     *
+     * MPIでは、ランク間の通信を伴うゲートの前に対象の量子ビットを各ランク内の位置に移す。
+     * 移す先には、以降のゲートで通信を伴う対象となるのが最も遅い量子ビットの位置を選ぶ。
+     * 格納位置はStateVector::set_qubit_mapと同様に記録され、結果には影響しない。
+     * @param state 作用させる量子状態
+     */
+    template <StateVectorImplementation IMPL>
+    void update_quantum_state(StateVector<IMPL>& state) const;
+
+    /**
+     * @brief apply all gates to state in order, keeping low-qubit gates in
+     * cache
+     * \~japanese-en 下位量子ビットのゲートをキャッシュ上でまとめて作用させる
+     *
+     * 作用量子ビットが全て<code>block_qubit_count</code>未満のゲートが連続する区間は、
+     * 量子状態を2^block_qubit_count要素のブロックに分け、
+     * ブロックごとに区間内の全ゲートを作用させる。
+     * それ以外のゲートは通常通り状態全体に作用させる。
+     * DEFAULT、DEFAULT_F32で有効。MPIではupdate_quantum_stateと同じ。
+     * @param state 作用させる量子状態
+     * @param block_qubit_count ブロックの量子ビット数
+     */
+    template <StateVectorImplementation IMPL>
+    void update_quantum_state_blocked(
+        StateVector<IMPL>& state, UINT block_qubit_count = 15) const;
+
+    /**
+     * @brief merge adjacent gates into dense matrix gates
+     * \~japanese-en 隣接するゲートを密行列ゲートにまとめる
+     *
+     * 先頭から順に、まとめた後の作用量子ビット数が
+     * <code>max_block_qubit_count</code>を超えない限りゲートを合成する。
+     * 合成対象が1つだけのゲートはそのまま残す。
+     * 密行列ゲートのコストは作用量子ビット数に対して指数的に増えるので、
+     * <code>max_block_qubit_count</code>は5程度までを推奨する。
+     * @param max_block_qubit_count 合成後のゲートの最大量子ビット数
+     */
+    void fuse_gates(UINT max_block_qubit_count = 3);
+};
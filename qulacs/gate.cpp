@@ -0,0 +1,243 @@
+#include "gate.hpp"
+
+#include <cmath>
+
+#include "internal/general/check_constraints.hpp"
+#include "internal/general/constant.hpp"
+
+constexpr StateVectorImplementation DEFAULT =
+    StateVectorImplementation::DEFAULT;
+constexpr StateVectorImplementation DEFAULT_F32 =
+    StateVectorImplementation::DEFAULT_F32;
+constexpr StateVectorImplementation MPI = StateVectorImplementation::MPI;
+
+std::vector<UINT> Gate::get_qubit_index_list() const {
+    std::vector<UINT> qubit_index_list = target_qubit_index_list;
+    qubit_index_list.insert(qubit_index_list.end(),
+        control_qubit_index_list.begin(), control_qubit_index_list.end());
+    return qubit_index_list;
+}
+
+std::vector<CTYPE> Gate::get_matrix() const {
+    std::vector<CTYPE> target_matrix;
+    switch (type) {
+        case GateType::X:
+            target_matrix.assign(PAULI_MATRIX[1], PAULI_MATRIX[1] + 4);
+            break;
+        case GateType::Y:
+            target_matrix.assign(PAULI_MATRIX[2], PAULI_MATRIX[2] + 4);
+            break;
+        case GateType::Z:
+            target_matrix.assign(PAULI_MATRIX[3], PAULI_MATRIX[3] + 4);
+            break;
+        case GateType::S:
+            target_matrix.assign(S_GATE_MATRIX, S_GATE_MATRIX + 4);
+            break;
+        case GateType::Sdag:
+            target_matrix.assign(S_DAG_GATE_MATRIX, S_DAG_GATE_MATRIX + 4);
+            break;
+        case GateType::T:
+            target_matrix = {1., 0., 0., CTYPE(1. / SQRT2, 1. / SQRT2)};
+            break;
+        case GateType::Tdag:
+            target_matrix = {1., 0., 0., CTYPE(1. / SQRT2, -1. / SQRT2)};
+            break;
+        case GateType::P0:
+            target_matrix.assign(PROJ_0_MATRIX, PROJ_0_MATRIX + 4);
+            break;
+        case GateType::P1:
+            target_matrix.assign(PROJ_1_MATRIX, PROJ_1_MATRIX + 4);
+            break;
+        case GateType::RZ:
+            target_matrix = {CTYPE(cos(angle / 2), -sin(angle / 2)), 0., 0.,
+                CTYPE(cos(angle / 2), sin(angle / 2))};
+            break;
+        case GateType::DiagonalMatrix:
+            target_matrix = {matrix[0], 0., 0., matrix[1]};
+            break;
+        case GateType::DenseMatrix:
+            target_matrix = matrix;
+            break;
+    }
+    if (control_qubit_index_list.empty()) return target_matrix;
+
+    // identity except the block selected by the control values
+    const UINT target_count = target_qubit_index_list.size();
+    const ITYPE target_dim = 1ULL << target_count;
+    const ITYPE dim = 1ULL << (target_count + control_qubit_index_list.size());
+    ITYPE control_mask = 0;
+    for (UINT i = 0; i < control_value_list.size(); ++i) {
+        control_mask |= (ITYPE)control_value_list[i] << (target_count + i);
+    }
+    std::vector<CTYPE> full_matrix(dim * dim, 0.);
+    for (ITYPE i = 0; i < dim; ++i) {
+        if ((i & ~(target_dim - 1)) != control_mask) {
+            full_matrix[i * dim + i] = 1.;
+        }
+    }
+    for (ITYPE y = 0; y < target_dim; ++y) {
+        for (ITYPE x = 0; x < target_dim; ++x) {
+            full_matrix[(control_mask | y) * dim + (control_mask | x)] =
+                target_matrix[y * target_dim + x];
+        }
+    }
+    return full_matrix;
+}
+
+template <StateVectorImplementation IMPL>
+void Gate::update_quantum_state(StateVector<IMPL>& state) const {
+    switch (type) {
+        case GateType::X:
+            state.apply_X(target_qubit_index_list[0]);
+            break;
+        case GateType::Y:
+            state.apply_Y(target_qubit_index_list[0]);
+            break;
+        case GateType::Z:
+            state.apply_Z(target_qubit_index_list[0]);
+            break;
+        case GateType::S:
+            state.apply_S(target_qubit_index_list[0]);
+            break;
+        case GateType::Sdag:
+            state.apply_Sdag(target_qubit_index_list[0]);
+            break;
+        case GateType::T:
+            state.apply_T(target_qubit_index_list[0]);
+            break;
+        case GateType::Tdag:
+            state.apply_Tdag(target_qubit_index_list[0]);
+            break;
+        case GateType::P0:
+            state.apply_P0(target_qubit_index_list[0]);
+            break;
+        case GateType::P1:
+            state.apply_P1(target_qubit_index_list[0]);
+            break;
+        case GateType::RZ:
+            state.apply_RZ(target_qubit_index_list[0], angle);
+            break;
+        case GateType::DiagonalMatrix:
+            state.apply_single_qubit_diagonal_matrix(
+                target_qubit_index_list[0], matrix.data());
+            break;
+        case GateType::DenseMatrix:
+            if (target_qubit_index_list.size() == 1 &&
+                control_qubit_index_list.empty()) {
+                state.apply_single_qubit_dense_matrix(
+                    target_qubit_index_list[0], matrix.data());
+            } else {
+                state.apply_multi_qubit_dense_matrix(target_qubit_index_list,
+                    matrix, control_qubit_index_list, control_value_list);
+            }
+            break;
+    }
+}
+
+template void Gate::update_quantum_state(StateVector<DEFAULT>& state) const;
+template void Gate::update_quantum_state(
+    StateVector<DEFAULT_F32>& state) const;
+#ifdef _USE_MPI
+template void Gate::update_quantum_state(StateVector<MPI>& state) const;
+#endif
+
+namespace gate {
+static Gate create_named_gate(GateType type, UINT target_qubit_index) {
+    Gate gate;
+    gate.type = type;
+    gate.target_qubit_index_list = {target_qubit_index};
+    return gate;
+}
+
+Gate X(UINT target_qubit_index) {
+    return create_named_gate(GateType::X, target_qubit_index);
+}
+
+Gate Y(UINT target_qubit_index) {
+    return create_named_gate(GateType::Y, target_qubit_index);
+}
+
+Gate Z(UINT target_qubit_index) {
+    return create_named_gate(GateType::Z, target_qubit_index);
+}
+
+Gate H(UINT target_qubit_index) {
+    return DenseMatrix({target_qubit_index},
+        std::vector<CTYPE>(HADAMARD_MATRIX, HADAMARD_MATRIX + 4));
+}
+
+Gate S(UINT target_qubit_index) {
+    return create_named_gate(GateType::S, target_qubit_index);
+}
+
+Gate Sdag(UINT target_qubit_index) {
+    return create_named_gate(GateType::Sdag, target_qubit_index);
+}
+
+Gate T(UINT target_qubit_index) {
+    return create_named_gate(GateType::T, target_qubit_index);
+}
+
+Gate Tdag(UINT target_qubit_index) {
+    return create_named_gate(GateType::Tdag, target_qubit_index);
+}
+
+Gate P0(UINT target_qubit_index) {
+    return create_named_gate(GateType::P0, target_qubit_index);
+}
+
+Gate P1(UINT target_qubit_index) {
+    return create_named_gate(GateType::P1, target_qubit_index);
+}
+
+Gate RZ(UINT target_qubit_index, double angle) {
+    Gate gate = create_named_gate(GateType::RZ, target_qubit_index);
+    gate.angle = angle;
+    return gate;
+}
+
+Gate CNOT(UINT control_qubit_index, UINT target_qubit_index) {
+    return DenseMatrix({target_qubit_index},
+        std::vector<CTYPE>(PAULI_MATRIX[1], PAULI_MATRIX[1] + 4),
+        {control_qubit_index}, {1});
+}
+
+Gate CZ(UINT control_qubit_index, UINT target_qubit_index) {
+    return DenseMatrix({target_qubit_index},
+        std::vector<CTYPE>(PAULI_MATRIX[3], PAULI_MATRIX[3] + 4),
+        {control_qubit_index}, {1});
+}
+
+Gate Toffoli(UINT control_qubit_index1, UINT control_qubit_index2,
+    UINT target_qubit_index) {
+    return DenseMatrix({target_qubit_index},
+        std::vector<CTYPE>(PAULI_MATRIX[1], PAULI_MATRIX[1] + 4),
+        {control_qubit_index1, control_qubit_index2}, {1, 1});
+}
+
+Gate DiagonalMatrix(
+    UINT target_qubit_index, const std::vector<CTYPE>& diagonal_matrix) {
+    check_equal(
+        "diagonal_matrix.size()", (UINT)diagonal_matrix.size(), (UINT)2);
+    Gate gate = create_named_gate(GateType::DiagonalMatrix, target_qubit_index);
+    gate.matrix = diagonal_matrix;
+    return gate;
+}
+
+Gate DenseMatrix(const std::vector<UINT>& target_qubit_index_list,
+    const std::vector<CTYPE>& matrix,
+    const std::vector<UINT>& control_qubit_index_list,
+    const std::vector<UINT>& control_value_list) {
+    check_equal("matrix.size()", (ITYPE)matrix.size(),
+        1ULL << (2 * target_qubit_index_list.size()));
+    check_equal("control_value_list.size()", (UINT)control_value_list.size(),
+        (UINT)control_qubit_index_list.size());
+    Gate gate;
+    gate.type = GateType::DenseMatrix;
+    gate.target_qubit_index_list = target_qubit_index_list;
+    gate.control_qubit_index_list = control_qubit_index_list;
+    gate.control_value_list = control_value_list;
+    gate.matrix = matrix;
+    return gate;
+}
+}  // namespace gate
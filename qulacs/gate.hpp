@@ -0,0 +1,141 @@
+/**
+ * @file gate.hpp
+ * @brief Gate class definition
+ */
+
+#pragma once
+#include <vector>
+
+#include "internal/general/type.hpp"
+#include "state_vector.hpp"
+
+/**
+ * @brief type of Gate
+ */
+enum class GateType {
+    X,
+    Y,
+    Z,
+    S,
+    Sdag,
+    T,
+    Tdag,
+    P0,
+    P1,
+    RZ,
+    DiagonalMatrix,
+    DenseMatrix
+};
+
+/**
+ * @brief quantum gate acting on StateVector
+ * \~japanese-en StateVectorに作用する量子ゲート
+ */
+struct Gate {
+    /**
+     * @brief type of the gate
+     * \~japanese-en ゲートの種類
+     */
+    GateType type;
+
+    /**
+     * @brief indices of target qubits
+     * \~japanese-en ターゲット量子ビットのインデックスのリスト
+     */
+    std::vector<UINT> target_qubit_index_list;
+
+    /**
+     * @brief indices of control qubits (only for DenseMatrix)
+     * \~japanese-en 制御量子ビットのインデックスのリスト (DenseMatrixのみ)
+     */
+    std::vector<UINT> control_qubit_index_list;
+
+    /**
+     * @brief values of control qubits
+     * \~japanese-en 制御量子ビットの値のリスト
+     */
+    std::vector<UINT> control_value_list;
+
+    /**
+     * @brief matrix elements. diagonal elements for DiagonalMatrix, row-major
+     * dense matrix for DenseMatrix
+     * \~japanese-en
+     * 行列要素。DiagonalMatrixでは対角成分、DenseMatrixでは行優先の密行列
+     */
+    std::vector<CTYPE> matrix;
+
+    /**
+     * @brief rotation angle (only for RZ)
+     * \~japanese-en 回転角 (RZのみ)
+     */
+    double angle = 0.;
+
+    /**
+     * @brief get indices of qubits the gate acts on. targets come first, then
+     * controls.
+     * \~japanese-en
+     * ゲートが作用する量子ビットのインデックスを、ターゲット、制御の順で返す
+     */
+    std::vector<UINT> get_qubit_index_list() const;
+
+    /**
+     * @brief get dense matrix on get_qubit_index_list()
+     * \~japanese-en
+     * get_qubit_index_list()の量子ビット上の密行列を返す。
+     *
+     * 行列の添え字のiビット目はget_qubit_index_list()のi番目に対応する。
+     * @return 行優先で並べた密行列
+     */
+    std::vector<CTYPE> get_matrix() const;
+
+    /**
+     * @brief apply the gate to state
+     * \~japanese-en 量子状態にゲートを作用させる
+     *
+     * @param state 作用させる量子状態
+     */
+    template <StateVectorImplementation IMPL>
+    void update_quantum_state(StateVector<IMPL>& state) const;
+};
+
+namespace gate {
+DllExport Gate X(UINT target_qubit_index);
+DllExport Gate Y(UINT target_qubit_index);
+DllExport Gate Z(UINT target_qubit_index);
+DllExport Gate H(UINT target_qubit_index);
+DllExport Gate S(UINT target_qubit_index);
+DllExport Gate Sdag(UINT target_qubit_index);
+DllExport Gate T(UINT target_qubit_index);
+DllExport Gate Tdag(UINT target_qubit_index);
+DllExport Gate P0(UINT target_qubit_index);
+DllExport Gate P1(UINT target_qubit_index);
+DllExport Gate RZ(UINT target_qubit_index, double angle);
+DllExport Gate CNOT(UINT control_qubit_index, UINT target_qubit_index);
+DllExport Gate CZ(UINT control_qubit_index, UINT target_qubit_index);
+DllExport Gate Toffoli(UINT control_qubit_index1, UINT control_qubit_index2,
+    UINT target_qubit_index);
+
+/**
+ * @brief create single qubit diagonal matrix gate
+ * \~japanese-en 1量子ビットの対角行列ゲートを作成する
+ *
+ * @param[in] target_qubit_index ターゲット量子ビットのインデックス
+ * @param[in] diagonal_matrix 対角成分
+ */
+DllExport Gate DiagonalMatrix(
+    UINT target_qubit_index, const std::vector<CTYPE>& diagonal_matrix);
+
+/**
+ * @brief create dense matrix gate
+ * \~japanese-en 密行列ゲートを作成する
+ *
+ * @param[in] target_qubit_index_list ターゲット量子ビットのインデックスのリスト
+ * @param[in] matrix 行優先で並べた2^k x 2^k行列
+ * @param[in] control_qubit_index_list 制御量子ビットのインデックスのリスト
+ * @param[in] control_value_list 制御量子ビットの値のリスト
+ */
+DllExport Gate DenseMatrix(const std::vector<UINT>& target_qubit_index_list,
+    const std::vector<CTYPE>& matrix,
+    const std::vector<UINT>& control_qubit_index_list = {},
+    const std::vector<UINT>& control_value_list = {});
+}  // namespace gate
@@ -10,8 +10,40 @@
 #include "../general/type.hpp"
 
 namespace normal {
-DllExport void initialize_quantum_state(std::vector<CTYPE>& state);
+template <typename FP>
+DllExport void initialize_quantum_state(std::complex<FP>* state, ITYPE dim);
 
+/**
+ * Copy the <code>dim</code> amplitudes of <code>source</code> to
+ * <code>state</code>, converted to the precision of <code>state</code>.
+ *
+ * The copy is split over threads like initialize_quantum_state, so that the
+ * pages of <code>state</code> are first touched by the threads using them.
+ */
+template <typename FP>
+DllExport void load_quantum_state(
+    const CTYPE* source, std::complex<FP>* state, ITYPE dim);
+
+/**
+ * Compute the squared norm of the <code>dim</code> unnormalized amplitudes
+ * that fill_Haar_random_state writes from <code>basis_offset</code>.
+ */
+DllExport double Haar_random_squared_norm(
+    ITYPE dim, UINT seed, ITYPE basis_offset);
+
+/**
+ * Write the amplitudes at basis <code>basis_offset</code> to
+ * <code>basis_offset + dim - 1</code> of the Haar random state of
+ * <code>seed</code>, multiplied by <code>normalizer</code>.
+ *
+ * The amplitude at basis i only depends on (seed, i), so a state split into
+ * slabs is the same as the state generated at once.
+ */
+template <typename FP>
+DllExport void fill_Haar_random_state(std::complex<FP>* state, ITYPE dim,
+    UINT seed, ITYPE basis_offset, double normalizer);
+
+template <typename FP>
 DllExport void initialize_Haar_random_state(
-    std::vector<CTYPE>& state, UINT seed);
+    std::complex<FP>* state, ITYPE dim, UINT seed);
 }  // namespace normal
\ No newline at end of file
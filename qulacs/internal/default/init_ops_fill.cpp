@@ -7,23 +7,25 @@
 #include "init_ops.hpp"
 
 namespace normal {
-void initialize_quantum_state_parallel(std::vector<CTYPE>& state);
+template <typename FP>
+void initialize_quantum_state_parallel(std::complex<FP>* state, ITYPE dim);
 
-void initialize_quantum_state(std::vector<CTYPE>& state) {
-    ITYPE index;
+template <typename FP>
+void initialize_quantum_state(std::complex<FP>* state, ITYPE dim) {
 #ifdef _OPENMP
-    OMPutil::get_inst().set_qulacs_num_threads(state.size(), 15);
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 15);
 #endif
 
-    initialize_quantum_state_parallel(state);
+    initialize_quantum_state_parallel(state, dim);
 
 #ifdef _OPENMP
     OMPutil::get_inst().reset_qulacs_num_threads();
 #endif
 }
 
-void initialize_quantum_state_parallel(std::vector<CTYPE>& state) {
-    ITYPE index, dim = state.size();
+template <typename FP>
+void initialize_quantum_state_parallel(std::complex<FP>* state, ITYPE dim) {
+    ITYPE index;
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
@@ -32,4 +34,31 @@ void initialize_quantum_state_parallel(std::vector<CTYPE>& state) {
     }
     state[0] = 1.0;
 }
+
+template <typename FP>
+void load_quantum_state(
+    const CTYPE* source, std::complex<FP>* state, ITYPE dim) {
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 15);
+#endif
+
+    ITYPE index;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (index = 0; index < dim; ++index) {
+        state[index] = static_cast<std::complex<FP>>(source[index]);
+    }
+
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template void initialize_quantum_state(CTYPE* state, ITYPE dim);
+template void initialize_quantum_state(CTYPE_F32* state, ITYPE dim);
+template void load_quantum_state(
+    const CTYPE* source, CTYPE* state, ITYPE dim);
+template void load_quantum_state(
+    const CTYPE* source, CTYPE_F32* state, ITYPE dim);
 }  // namespace normal
\ No newline at end of file
@@ -1,8 +1,9 @@
-#include <limits.h>
-
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
 #include <vector>
 
-#ifdef _OPEMP
+#ifdef _OPENMP
 #include "../general/omp_util.hpp"
 #endif
 #include "../general/random.hpp"
@@ -10,79 +11,97 @@
 #include "init_ops.hpp"
 
 namespace normal {
-void initialize_Haar_random_state_single(std::vector<CTYPE>& state, UINT seed) {
-    ITYPE dim = state.size();
-    constexpr static int ignore_first = 40;
-    double norm = 0.;
-    Random random(seed);
-    for (int i = 0; i < ignore_first; ++i) random.int64();
-    for (ITYPE index = 0; index < dim; ++index) {
-        double r1 = random.normal(), r2 = random.normal();
-        state[index] = r1 + 1.i * r2;
-        norm += r1 * r1 + r2 * r2;
-    }
-    norm = sqrt(norm);
-    for (ITYPE index = 0; index < dim; ++index) {
-        state[index] /= norm;
-    }
-}
+// Norms are summed over blocks of fixed size so that the result does not
+// depend on the number of threads.
+constexpr UINT HAAR_BLOCK_QUBIT_COUNT = 13;
+
+double Haar_random_squared_norm(ITYPE dim, UINT seed, ITYPE basis_offset) {
+    const ITYPE block_dim =
+        std::min(dim, (ITYPE)1 << HAAR_BLOCK_QUBIT_COUNT);
+    const ITYPE block_count = dim / block_dim;
+    std::vector<double> norm_list(block_count);
 
+    // The norm only depends on the radii of Box-Muller, so it is known
+    // before generating the state.
 #ifdef _OPENMP
-void initialize_Haar_random_state_parallel(
-    std::vector<CTYPE>& state, UINT seed) {
-    ITYPE dim = state.size();
-    // multi thread
     OMPutil::get_inst().set_qulacs_num_threads(dim, 10);
-    constexpr static int ignore_first = 40;
-    const UINT thread_count = omp_get_max_threads();
-    const ITYPE block_size = dim / thread_count;
-    const ITYPE residual = dim % thread_count;
+#pragma omp parallel for
+#endif
+    for (ITYPE block_index = 0; block_index < block_count; ++block_index) {
+        PhiloxEngine engine(seed);
+        engine.set_offset(2 * (basis_offset + block_index * block_dim));
+        norm_list[block_index] = engine.sum_squared_normal(2 * block_dim);
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
 
-    std::vector<Random> generator_list(thread_count);
-    for (UINT i = 0; i < thread_count; ++i) {
-        generator_list[i] = Random(seed ^ i);
+    double norm = 0.;
+    for (ITYPE block_index = 0; block_index < block_count; ++block_index) {
+        norm += norm_list[block_index];
     }
+    return norm;
+}
 
-    std::vector<double> norm_list(thread_count);
+template <typename FP>
+void fill_Haar_random_state(std::complex<FP>* state, ITYPE dim, UINT seed,
+    ITYPE basis_offset, double normalizer) {
+    const ITYPE block_dim =
+        std::min(dim, (ITYPE)1 << HAAR_BLOCK_QUBIT_COUNT);
+    const ITYPE block_count = dim / block_dim;
+
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 10);
 #pragma omp parallel
+#endif
     {
-        UINT thread_id = omp_get_thread_num();
-        ITYPE start_index = block_size * thread_id +
-                            (residual > thread_id ? thread_id : residual);
-        ITYPE end_index =
-            block_size * (thread_id + 1) +
-            (residual > (thread_id + 1) ? (thread_id + 1) : residual);
-        ITYPE index;
-
-        // ignore first randoms
-        for (int i = 0; i < ignore_first; ++i) generator_list[i].int64();
-
-        for (index = start_index; index < end_index; ++index) {
-            double r1 = generator_list[i].normal(),
-                   r2 = generator_list[i].normal();
-            state[index] = r1 + 1.i * r2;
-            norm_list[thread_id] += r1 * r1 + r2 * r2;
+        std::vector<double> buffer;
+        if constexpr (!std::is_same_v<FP, double>) {
+            buffer.resize(2 * block_dim);
+        }
+        ITYPE block_index;
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for (block_index = 0; block_index < block_count; ++block_index) {
+            const ITYPE block_begin = block_index * block_dim;
+            PhiloxEngine engine(seed);
+            engine.set_offset(2 * (basis_offset + block_begin));
+            if constexpr (std::is_same_v<FP, double>) {
+                // std::complex<double> is an array of two doubles
+                engine.fill_normal(
+                    reinterpret_cast<double*>(state + block_begin),
+                    2 * block_dim, normalizer);
+            } else {
+                engine.fill_normal(buffer.data(), 2 * block_dim, normalizer);
+                for (ITYPE i = 0; i < block_dim; ++i) {
+                    state[block_begin + i] =
+                        std::complex<FP>(buffer[2 * i], buffer[2 * i + 1]);
+                }
+            }
         }
     }
-
-    double normalizer = 0.;
-    for (UINT i = 0; i < thread_count; ++i) {
-        normalizer += norm_list[i];
-    }
-    normalizer = 1. / sqrt(normalizer);
-#pragma omp parallel for
-    for (ITYPE index = 0; index < dim; ++index) {
-        state[index] *= normalizer;
-    }
+#ifdef _OPENMP
     OMPutil::get_inst().reset_qulacs_num_threads();
-}
 #endif
+}
 
-void initialize_Haar_random_state(std::vector<CTYPE>& state, UINT seed) {
-#ifdef _OPENMP
-    initialize_Haar_random_state_parallel(state, seed);
-#else
-    initialize_Haar_random_state_single(state, seed);
-#endif
+template <typename FP>
+void initialize_Haar_random_state(
+    std::complex<FP>* state, ITYPE dim, UINT seed) {
+    // the amplitude at index i is made from the i-th Philox block, i.e. the
+    // (2i)-th and (2i+1)-th outputs of stream 0. The state is written once,
+    // already normalized.
+    const double norm = Haar_random_squared_norm(dim, seed, 0);
+    fill_Haar_random_state(state, dim, seed, 0, 1. / sqrt(norm));
 }
-}  // namespace normal
\ No newline at end of file
+
+template void fill_Haar_random_state(CTYPE* state, ITYPE dim, UINT seed,
+    ITYPE basis_offset, double normalizer);
+template void fill_Haar_random_state(CTYPE_F32* state, ITYPE dim, UINT seed,
+    ITYPE basis_offset, double normalizer);
+template void initialize_Haar_random_state(
+    CTYPE* state, ITYPE dim, UINT seed);
+template void initialize_Haar_random_state(
+    CTYPE_F32* state, ITYPE dim, UINT seed);
+}  // namespace normal
@@ -1,19 +1,27 @@
 #include "stat_ops.hpp"
 
+#ifdef _OPENMP
+#include "../general/omp_util.hpp"
+#endif
+
 namespace normal {
-double state_norm_squared(const std::vector<CTYPE>& state) {
+template <typename FP>
+double state_norm_squared(const std::complex<FP>* state, ITYPE dim) {
     double norm = 0;
+    const ITYPE loop_dim = dim;
 #ifdef _OPENMP
-    OMPutil::get_inst().set_qulacs_num_threads(dim, 10);
+    OMPutil::get_inst().set_qulacs_num_threads(loop_dim, 10);
 #pragma omp parallel for reduction(+ : norm)
 #endif
-    for (ITYPE state_index = 0, loop_dim = state.size(); state_index < loop_dim;
-         ++state_index) {
-        norm += std::norm(state[state_index])
+    for (ITYPE state_index = 0; state_index < loop_dim; ++state_index) {
+        norm += std::norm(std::complex<double>(state[state_index]));
     }
 #ifdef _OPENMP
     OMPutil::get_inst().reset_qulacs_num_threads();
 #endif
     return norm;
 }
+
+template double state_norm_squared(const CTYPE* state, ITYPE dim);
+template double state_norm_squared(const CTYPE_F32* state, ITYPE dim);
 }  // namespace normal
\ No newline at end of file
@@ -1,6 +1,9 @@
 /**
  * @file stat_ops.hpp
  * @brief functions of measuring state vector
+ *
+ * Reductions accumulate in double precision regardless of the precision of
+ * the state vector.
  */
 
 #pragma once
@@ -10,15 +13,134 @@
 #include "../general/type.hpp"
 
 namespace normal {
+template <typename FP>
 DllExport double m0_prob(
-    const std::vector<CTYPE>& state, UINT target_qubit_index);
+    const std::complex<FP>* state, ITYPE dim, UINT target_qubit_index);
 
-DllExport double marginal_prob(const std::vector<CTYPE>& state,
+template <typename FP>
+DllExport double marginal_prob(const std::complex<FP>* state, ITYPE dim,
     const std::vector<UINT>& sorted_target_qubit_index_list,
     const std::vector<UINT>& measured_value_list);
 
+/**
+ * Compute the probability of observing 0 on every qubit in one contiguous
+ * sweep of the state.
+ */
+template <typename FP>
+DllExport std::vector<double> zero_probabilities(
+    const std::complex<FP>* state, ITYPE dim);
+
+/**
+ * Compute the distribution of the outcomes of measuring
+ * <code>target_qubit_index_list</code> in one contiguous sweep of the state.
+ *
+ * Bit i of the index of the result is the outcome of
+ * <code>target_qubit_index_list[i]</code>. Each thread holds a histogram of
+ * 2^k doubles, where k is the number of targets.
+ */
+template <typename FP>
+DllExport std::vector<double> marginal_distribution(
+    const std::complex<FP>* state, ITYPE dim,
+    const std::vector<UINT>& target_qubit_index_list);
+
+template <typename FP>
 DllExport double measurement_distribution_entropy(
-    const std::vector<CTYPE>& state);
+    const std::complex<FP>* state, ITYPE dim);
+
+template <typename FP>
+DllExport double state_norm_squared(const std::complex<FP>* state, ITYPE dim);
 
-DllExport double state_norm_squared(const std::vector<CTYPE>& state);
+/**
+ * Compute sum_t coef_list[t] <psi|P_t|psi> for Pauli strings P_t that share
+ * the X mask <code>x_mask</code>, in one sweep of the state.
+ *
+ * A qubit of P_t is X if it is only in <code>x_mask</code>, Z if it is only
+ * in <code>z_mask_list[t]</code>, and Y if it is in both.
+ */
+template <typename FP>
+DllExport CTYPE expectation_value_pauli_group(const std::complex<FP>* state,
+    ITYPE dim, ITYPE x_mask, const std::vector<ITYPE>& z_mask_list,
+    const std::vector<CTYPE>& coef_list);
+
+/**
+ * Compute several statistics in a single sweep of the state.
+ *
+ * @param[in] compute_entropy whether to compute <code>entropy</code>
+ * @param[in] compute_zero_probability whether to compute
+ * <code>zero_probability_list</code>
+ * @param[in] marginal_mask_list bits fixed by each marginal
+ * @param[in] marginal_value_list values of the fixed bits of each marginal
+ * @param[out] squared_norm squared norm, always computed
+ * @param[out] entropy entropy of the measurement distribution
+ * @param[out] zero_probability_list probability of observing 0 on each
+ * qubit, or empty if not requested
+ * @param[out] marginal_probability_list probability of each marginal
+ */
+template <typename FP>
+DllExport void fused_statistics(const std::complex<FP>* state, ITYPE dim,
+    bool compute_entropy, bool compute_zero_probability,
+    const std::vector<ITYPE>& marginal_mask_list,
+    const std::vector<ITYPE>& marginal_value_list, double& squared_norm,
+    double& entropy, std::vector<double>& zero_probability_list,
+    std::vector<double>& marginal_probability_list);
+
+/**
+ * Generate <code>count</code> sorted uniform random numbers on
+ * \f$[0, scale)\f$ in O(count) from normalized sums of exponential spacings.
+ * The prefix sum is a blocked parallel scan.
+ */
+DllExport std::vector<double> generate_sorted_uniforms(
+    ITYPE count, double scale, UINT seed);
+
+/**
+ * Shuffle samples drawn in the sorted order so that shots are independent.
+ */
+DllExport void shuffle_samples(std::vector<ITYPE>& samples, UINT seed);
+
+/**
+ * Compute the prefix sums of probabilities over the blocks used by
+ * sample_sorted_uniforms. The last element is the squared norm.
+ */
+template <typename FP>
+DllExport std::vector<double> sampling_block_offset(
+    const std::complex<FP>* state, ITYPE dim);
+
+/**
+ * Map sorted uniforms to basis indices in one sweep of the state.
+ *
+ * The probabilities of <code>state</code> are laid on
+ * \f$[uniform\_offset, uniform\_offset + norm)\f$, and every uniform must
+ * be in this range.
+ * @param[in] block_offset result of sampling_block_offset
+ * @param[out] samples basis index of each uniform
+ */
+template <typename FP>
+DllExport void sample_sorted_uniforms(const std::complex<FP>* state,
+    ITYPE dim, const std::vector<double>& block_offset, const double* uniforms,
+    ITYPE count, double uniform_offset, ITYPE* samples);
+
+/**
+ * Sample computational basis without building a cumulative table.
+ *
+ * Sorted uniforms are merged with the probabilities block by block in two
+ * sweeps of the state, O(dim + sampling_count) in total.
+ */
+template <typename FP>
+DllExport std::vector<ITYPE> sampling(const std::complex<FP>* state,
+    ITYPE dim, UINT sampling_count, UINT seed);
+
+/**
+ * Compute the inclusive prefix sum of probabilities into
+ * <code>cumulative</code> of length <code>dim</code> by a blocked parallel
+ * scan.
+ */
+template <typename FP>
+DllExport void cumulative_probability(
+    const std::complex<FP>* state, ITYPE dim, double* cumulative);
+
+/**
+ * Sample computational basis from the table made by cumulative_probability.
+ */
+DllExport std::vector<ITYPE> sampling_from_cumulative_probability(
+    const double* cumulative, ITYPE dim, UINT sampling_count, UINT seed);
 }  // namespace normal
\ No newline at end of file
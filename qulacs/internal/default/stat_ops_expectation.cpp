@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <vector>
+
+#include "../general/number_util.hpp"
+#ifdef _OPENMP
+#include "../general/omp_util.hpp"
+#endif
+#include "stat_ops.hpp"
+
+namespace normal {
+// The state is processed in chunks of 2^10 basis. Inside a chunk the signs
+// of all Z masks of a group are resolved at once by a Walsh-Hadamard
+// transform over the low qubits that appear in some Z mask.
+constexpr UINT PAULI_CHUNK_QUBIT_COUNT = 10;
+
+// W[z] = sum_b w[b] (-1)^popcount(b & z)
+inline static void walsh_hadamard_transform(
+    std::complex<double>* w, ITYPE size) {
+    for (ITYPE half = 1; half < size; half <<= 1) {
+        for (ITYPE begin = 0; begin < size; begin += 2 * half) {
+            for (ITYPE i = begin; i < begin + half; ++i) {
+                const std::complex<double> a = w[i], b = w[i + half];
+                w[i] = a + b;
+                w[i + half] = a - b;
+            }
+        }
+    }
+}
+
+// Gather the bits of value selected by mask into the low bits.
+inline static ITYPE extract_bits(ITYPE value, ITYPE mask) {
+    ITYPE result = 0;
+    for (UINT cursor = 0; mask != 0; mask &= mask - 1, ++cursor) {
+        const ITYPE bit = mask & (~mask + 1);
+        if (value & bit) result |= (ITYPE)1 << cursor;
+    }
+    return result;
+}
+
+template <typename FP>
+CTYPE expectation_value_pauli_group(const std::complex<FP>* state, ITYPE dim,
+    ITYPE x_mask, const std::vector<ITYPE>& z_mask_list,
+    const std::vector<CTYPE>& coef_list) {
+    UINT qubit_count = 0;
+    while (((ITYPE)1 << qubit_count) < dim) ++qubit_count;
+    const UINT chunk_qubit_count =
+        std::min(qubit_count, PAULI_CHUNK_QUBIT_COUNT);
+    const ITYPE chunk_dim = (ITYPE)1 << chunk_qubit_count;
+    const ITYPE chunk_count = dim >> chunk_qubit_count;
+    const ITYPE low_mask = chunk_dim - 1;
+    const ITYPE x_low = x_mask & low_mask;
+    const ITYPE x_high = x_mask & ~low_mask;
+    const UINT term_count = z_mask_list.size();
+
+    // P|b> = i^{#Y} (-1)^popcount(b & z) |b ^ x>, so that
+    // <psi|P|psi> = i^{#Y} sum_b conj(psi[b ^ x]) psi[b] (-1)^popcount(b & z)
+    std::vector<CTYPE> weight_list(term_count);
+    const CTYPE phase_list[4] = {1., CTYPE(0., 1.), -1., CTYPE(0., -1.)};
+    ITYPE used_low_mask = 0;
+    for (UINT t = 0; t < term_count; ++t) {
+        const UINT y_count = count_population(x_mask & z_mask_list[t]);
+        weight_list[t] = coef_list[t] * phase_list[y_count % 4];
+        used_low_mask |= z_mask_list[t] & low_mask;
+    }
+
+    // Bits of a chunk that no Z mask reads are summed out before the
+    // transform, so its size is 2^(number of low qubits used).
+    const ITYPE transform_dim = (ITYPE)1 << count_population(used_low_mask);
+    std::vector<ITYPE> compressed_index(chunk_dim);
+    for (ITYPE i = 0; i < chunk_dim; ++i) {
+        compressed_index[i] = extract_bits(i, used_low_mask);
+    }
+    std::vector<ITYPE> compressed_z_list(term_count);
+    for (UINT t = 0; t < term_count; ++t) {
+        compressed_z_list[t] = extract_bits(z_mask_list[t], used_low_mask);
+    }
+
+    double sum_real = 0., sum_imag = 0.;
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 10);
+#pragma omp parallel reduction(+ : sum_real, sum_imag)
+#endif
+    {
+        std::vector<std::complex<double>> w(transform_dim);
+        ITYPE chunk_index;
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for (chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+            const ITYPE chunk_begin = chunk_index << chunk_qubit_count;
+            const std::complex<FP>* chunk = state + chunk_begin;
+            const std::complex<FP>* partner = state + (chunk_begin ^ x_high);
+            std::fill(w.begin(), w.end(), 0.);
+            for (ITYPE i = 0; i < chunk_dim; ++i) {
+                // written out to avoid the NaN handling of complex multiply
+                const double ar = partner[i ^ x_low].real();
+                const double ai = partner[i ^ x_low].imag();
+                const double br = chunk[i].real(), bi = chunk[i].imag();
+                w[compressed_index[i]] += std::complex<double>(
+                    ar * br + ai * bi, ar * bi - ai * br);
+            }
+            walsh_hadamard_transform(w.data(), transform_dim);
+
+            std::complex<double> chunk_sum = 0.;
+            for (UINT t = 0; t < term_count; ++t) {
+                std::complex<double> value = w[compressed_z_list[t]];
+                if (count_population(chunk_begin & z_mask_list[t]) & 1) {
+                    value = -value;
+                }
+                chunk_sum += weight_list[t] * value;
+            }
+            sum_real += chunk_sum.real();
+            sum_imag += chunk_sum.imag();
+        }
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+    return CTYPE(sum_real, sum_imag);
+}
+
+template CTYPE expectation_value_pauli_group(const CTYPE* state, ITYPE dim,
+    ITYPE x_mask, const std::vector<ITYPE>& z_mask_list,
+    const std::vector<CTYPE>& coef_list);
+template CTYPE expectation_value_pauli_group(const CTYPE_F32* state,
+    ITYPE dim, ITYPE x_mask, const std::vector<ITYPE>& z_mask_list,
+    const std::vector<CTYPE>& coef_list);
+}  // namespace normal
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#ifdef _OPENMP
+#include "../general/omp_util.hpp"
+#endif
+#include "stat_ops.hpp"
+
+namespace normal {
+// Probabilities are reduced over chunks of 2^6 basis. Statistics on the low
+// 6 qubits are summed inside a chunk, and the ones on the other qubits are
+// updated once per chunk from the chunk total.
+constexpr UINT FUSED_CHUNK_QUBIT_COUNT = 6;
+
+template <typename FP>
+void fused_statistics(const std::complex<FP>* state, ITYPE dim,
+    bool compute_entropy, bool compute_zero_probability,
+    const std::vector<ITYPE>& marginal_mask_list,
+    const std::vector<ITYPE>& marginal_value_list, double& squared_norm,
+    double& entropy, std::vector<double>& zero_probability_list,
+    std::vector<double>& marginal_probability_list) {
+    UINT qubit_count = 0;
+    while (((ITYPE)1 << qubit_count) < dim) ++qubit_count;
+    const UINT chunk_qubit_count =
+        std::min(qubit_count, FUSED_CHUNK_QUBIT_COUNT);
+    const ITYPE chunk_dim = (ITYPE)1 << chunk_qubit_count;
+    const ITYPE chunk_count = dim >> chunk_qubit_count;
+    const ITYPE chunk_mask = chunk_dim - 1;
+    const UINT zero_probability_count =
+        compute_zero_probability ? qubit_count : 0;
+    const UINT marginal_count = marginal_mask_list.size();
+
+    squared_norm = 0.;
+    entropy = 0.;
+    zero_probability_list.assign(zero_probability_count, 0.);
+    marginal_probability_list.assign(marginal_count, 0.);
+
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 10);
+#pragma omp parallel
+#endif
+    {
+        double norm_local = 0., entropy_local = 0.;
+        std::vector<double> zero_probability_local(zero_probability_count, 0.);
+        std::vector<double> marginal_local(marginal_count, 0.);
+        std::vector<double> prob(chunk_dim);
+        ITYPE chunk_index;
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for (chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+            const ITYPE chunk_begin = chunk_index << chunk_qubit_count;
+            double chunk_sum = 0.;
+            for (ITYPE i = 0; i < chunk_dim; ++i) {
+                prob[i] =
+                    std::norm(std::complex<double>(state[chunk_begin + i]));
+                chunk_sum += prob[i];
+            }
+            norm_local += chunk_sum;
+
+            if (compute_entropy) {
+                for (ITYPE i = 0; i < chunk_dim; ++i) {
+                    if (prob[i] > 0) {
+                        entropy_local -= prob[i] * std::log(prob[i]);
+                    }
+                }
+            }
+
+            for (UINT qubit = 0; qubit < zero_probability_count; ++qubit) {
+                if (qubit < chunk_qubit_count) {
+                    const ITYPE bit = (ITYPE)1 << qubit;
+                    double sum = 0.;
+                    for (ITYPE i = 0; i < chunk_dim; ++i) {
+                        if (!(i & bit)) sum += prob[i];
+                    }
+                    zero_probability_local[qubit] += sum;
+                } else if (!((chunk_begin >> qubit) & 1)) {
+                    zero_probability_local[qubit] += chunk_sum;
+                }
+            }
+
+            for (UINT m = 0; m < marginal_count; ++m) {
+                const ITYPE mask = marginal_mask_list[m];
+                const ITYPE value = marginal_value_list[m];
+                if ((chunk_begin & mask & ~chunk_mask) !=
+                    (value & ~chunk_mask)) {
+                    continue;
+                }
+                const ITYPE low_mask = mask & chunk_mask;
+                if (low_mask == 0) {
+                    marginal_local[m] += chunk_sum;
+                    continue;
+                }
+                const ITYPE low_value = value & chunk_mask;
+                double sum = 0.;
+                for (ITYPE i = 0; i < chunk_dim; ++i) {
+                    if ((i & low_mask) == low_value) sum += prob[i];
+                }
+                marginal_local[m] += sum;
+            }
+        }
+
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        {
+            squared_norm += norm_local;
+            entropy += entropy_local;
+            for (UINT qubit = 0; qubit < zero_probability_count; ++qubit) {
+                zero_probability_list[qubit] += zero_probability_local[qubit];
+            }
+            for (UINT m = 0; m < marginal_count; ++m) {
+                marginal_probability_list[m] += marginal_local[m];
+            }
+        }
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template void fused_statistics(const CTYPE* state, ITYPE dim,
+    bool compute_entropy, bool compute_zero_probability,
+    const std::vector<ITYPE>& marginal_mask_list,
+    const std::vector<ITYPE>& marginal_value_list, double& squared_norm,
+    double& entropy, std::vector<double>& zero_probability_list,
+    std::vector<double>& marginal_probability_list);
+template void fused_statistics(const CTYPE_F32* state, ITYPE dim,
+    bool compute_entropy, bool compute_zero_probability,
+    const std::vector<ITYPE>& marginal_mask_list,
+    const std::vector<ITYPE>& marginal_value_list, double& squared_norm,
+    double& entropy, std::vector<double>& zero_probability_list,
+    std::vector<double>& marginal_probability_list);
+}  // namespace normal
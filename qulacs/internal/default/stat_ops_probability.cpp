@@ -0,0 +1,336 @@
+#include <algorithm>
+#include <cmath>
+
+#include "../general/number_util.hpp"
+#ifdef _OPENMP
+#include "../general/omp_util.hpp"
+#endif
+#include "stat_ops.hpp"
+
+namespace normal {
+template <typename FP>
+double m0_prob(
+    const std::complex<FP>* state, ITYPE dim, UINT target_qubit_index) {
+    double sum = 0;
+    const ITYPE loop_dim = dim >> 1;
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 10);
+#pragma omp parallel for reduction(+ : sum)
+#endif
+    for (ITYPE state_index = 0; state_index < loop_dim; ++state_index) {
+        ITYPE basis_index =
+            insert_zero_to_basis_index(state_index, target_qubit_index);
+        sum += std::norm(std::complex<double>(state[basis_index]));
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+    return sum;
+}
+
+// Sum of squared norms of consecutive amplitudes. Four independent
+// accumulators let the compiler keep them in one vector register.
+template <typename FP>
+inline static double norm_sum(const std::complex<FP>* state, ITYPE count) {
+    const FP* value = reinterpret_cast<const FP*>(state);
+    const ITYPE value_count = 2 * count;
+    double acc[4] = {0., 0., 0., 0.};
+    ITYPE i = 0;
+    for (; i + 4 <= value_count; i += 4) {
+        for (UINT lane = 0; lane < 4; ++lane) {
+            const double v = value[i + lane];
+            acc[lane] += v * v;
+        }
+    }
+    for (; i < value_count; ++i) {
+        const double v = value[i];
+        acc[0] += v * v;
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+// Amplitudes in a cache line of 64 bytes. Measured qubits inside a line are
+// masked in a window instead of cutting it into runs shorter than a line,
+// since the whole line is read anyway.
+template <typename FP>
+constexpr ITYPE marginal_line_dim() {
+    return 64 / sizeof(std::complex<FP>);
+}
+
+// Sum of squared norms of consecutive amplitudes, each real and imaginary
+// part multiplied by <code>weight</code>, which repeats every line.
+template <typename FP>
+inline static double masked_norm_sum(const std::complex<FP>* state,
+    ITYPE count, const double weight[2 * marginal_line_dim<FP>()]) {
+    constexpr ITYPE line_value_count = 2 * marginal_line_dim<FP>();
+    const FP* value = reinterpret_cast<const FP*>(state);
+    const ITYPE value_count = 2 * count;
+    double acc[4] = {0., 0., 0., 0.};
+    ITYPE i = 0;
+    for (; i + line_value_count <= value_count; i += line_value_count) {
+        for (UINT lane = 0; lane < line_value_count; ++lane) {
+            const double v = value[i + lane];
+            acc[lane % 4] += weight[lane] * v * v;
+        }
+    }
+    // only a state smaller than a line has a tail
+    for (; i < value_count; ++i) {
+        const double v = value[i];
+        acc[0] += weight[i] * v * v;
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+// Windows of up to 2^12 consecutive basis are summed at once. A window ends
+// below the lowest measured qubit outside the first cache line.
+constexpr UINT MARGINAL_WINDOW_QUBIT_COUNT = 12;
+// A task of up to 2^10 windows inserts the measured bits once, and steps to
+// the next window with a masked carry.
+constexpr UINT MARGINAL_TASK_QUBIT_COUNT = 10;
+
+template <typename FP>
+double marginal_prob(const std::complex<FP>* state, ITYPE dim,
+    const std::vector<UINT>& sorted_target_qubit_index_list,
+    const std::vector<UINT>& measured_value_list) {
+    UINT qubit_count = 0;
+    while (((ITYPE)1 << qubit_count) < dim) ++qubit_count;
+    ITYPE fixed_mask = 0, fixed_value = 0;
+    for (UINT cursor = 0; cursor < sorted_target_qubit_index_list.size();
+         ++cursor) {
+        const UINT target = sorted_target_qubit_index_list[cursor];
+        fixed_mask |= (ITYPE)1 << target;
+        fixed_value |= (ITYPE)measured_value_list[cursor] << target;
+    }
+
+    // the window is free of measured qubits, except the masked ones in a line
+    constexpr ITYPE line_dim = marginal_line_dim<FP>();
+    const ITYPE masked_mask = fixed_mask & (line_dim - 1);
+    UINT window_qubit_count =
+        std::min(qubit_count, MARGINAL_WINDOW_QUBIT_COUNT);
+    for (UINT target : sorted_target_qubit_index_list) {
+        if (masked_mask != 0 && ((ITYPE)1 << target) < line_dim) continue;
+        window_qubit_count = std::min(window_qubit_count, target);
+    }
+    const ITYPE window_dim = (ITYPE)1 << window_qubit_count;
+    double weight[2 * line_dim];
+    for (ITYPE i = 0; i < line_dim; ++i) {
+        const double w = ((i & masked_mask) == (fixed_value & masked_mask));
+        weight[2 * i] = w;
+        weight[2 * i + 1] = w;
+    }
+
+    std::vector<UINT> outer_target_list;
+    for (UINT target : sorted_target_qubit_index_list) {
+        if (target >= window_qubit_count) outer_target_list.push_back(target);
+    }
+    const std::vector<ITYPE> insert_mask_list =
+        create_insert_zero_mask_list(outer_target_list);
+    // bits a step to the next window has to carry over
+    const ITYPE skip_mask = (fixed_mask & ~(window_dim - 1)) | (window_dim - 1);
+    const ITYPE window_count =
+        (dim >> outer_target_list.size()) >> window_qubit_count;
+    UINT task_qubit_count = 0;
+    while (task_qubit_count < MARGINAL_TASK_QUBIT_COUNT &&
+           ((ITYPE)2 << task_qubit_count) <= window_count) {
+        ++task_qubit_count;
+    }
+    const ITYPE task_dim = (ITYPE)1 << task_qubit_count;
+    const ITYPE task_count = window_count >> task_qubit_count;
+
+    double sum = 0;
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 10);
+#pragma omp parallel for reduction(+ : sum)
+#endif
+    for (ITYPE task_index = 0; task_index < task_count; ++task_index) {
+        ITYPE basis_index = insert_zeros_to_basis_index(
+            (task_index << task_qubit_count) << window_qubit_count,
+            insert_mask_list);
+        for (ITYPE i = 0; i < task_dim; ++i) {
+            const std::complex<FP>* window =
+                state + (basis_index | (fixed_value & ~(window_dim - 1)));
+            sum += (masked_mask == 0)
+                       ? norm_sum(window, window_dim)
+                       : masked_norm_sum(window, window_dim, weight);
+            basis_index = ((basis_index | skip_mask) + 1) & ~skip_mask;
+        }
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+    return sum;
+}
+
+// Contiguous chunks of 2^6 basis. The low qubits of a basis index are summed
+// inside a chunk, and the high qubits are the same for the whole chunk.
+constexpr UINT ZERO_PROBABILITY_CHUNK_QUBIT_COUNT = 6;
+
+template <typename FP>
+std::vector<double> zero_probabilities(
+    const std::complex<FP>* state, ITYPE dim) {
+    UINT qubit_count = 0;
+    while (((ITYPE)1 << qubit_count) < dim) ++qubit_count;
+    const UINT chunk_qubit_count =
+        std::min(qubit_count, ZERO_PROBABILITY_CHUNK_QUBIT_COUNT);
+    const ITYPE chunk_dim = (ITYPE)1 << chunk_qubit_count;
+    const ITYPE chunk_count = dim >> chunk_qubit_count;
+    std::vector<double> result(qubit_count, 0.);
+
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 10);
+#pragma omp parallel
+#endif
+    {
+        std::vector<double> accumulator(qubit_count, 0.);
+        ITYPE chunk_index;
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for (chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+            const std::complex<FP>* chunk =
+                state + (chunk_index << chunk_qubit_count);
+            double prob[(ITYPE)1 << ZERO_PROBABILITY_CHUNK_QUBIT_COUNT];
+            double chunk_sum = 0.;
+            for (ITYPE i = 0; i < chunk_dim; ++i) {
+                prob[i] = std::norm(std::complex<double>(chunk[i]));
+                chunk_sum += prob[i];
+            }
+            for (UINT qubit = 0; qubit < chunk_qubit_count; ++qubit) {
+                double sum = 0.;
+                for (ITYPE i = 0; i < (chunk_dim >> 1); ++i) {
+                    sum += prob[insert_zero_to_basis_index(i, qubit)];
+                }
+                accumulator[qubit] += sum;
+            }
+            // bit (qubit - chunk_qubit_count) of chunk_index is the qubit
+            ITYPE high_zero_bits = ~chunk_index;
+            for (UINT qubit = chunk_qubit_count; qubit < qubit_count;
+                 ++qubit) {
+                if (high_zero_bits & 1) accumulator[qubit] += chunk_sum;
+                high_zero_bits >>= 1;
+            }
+        }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        {
+            for (UINT qubit = 0; qubit < qubit_count; ++qubit) {
+                result[qubit] += accumulator[qubit];
+            }
+        }
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+    return result;
+}
+
+// Contiguous chunks of up to 2^10 basis. The outcome contributed by the low
+// bits of a basis index is looked up in a table, and the one by the high
+// bits is computed once per chunk.
+constexpr UINT MARGINAL_CHUNK_QUBIT_COUNT = 10;
+
+template <typename FP>
+std::vector<double> marginal_distribution(const std::complex<FP>* state,
+    ITYPE dim, const std::vector<UINT>& target_qubit_index_list) {
+    UINT qubit_count = 0;
+    while (((ITYPE)1 << qubit_count) < dim) ++qubit_count;
+    const UINT chunk_qubit_count =
+        std::min(qubit_count, MARGINAL_CHUNK_QUBIT_COUNT);
+    const ITYPE chunk_dim = (ITYPE)1 << chunk_qubit_count;
+    const ITYPE chunk_count = dim >> chunk_qubit_count;
+    const UINT target_count = target_qubit_index_list.size();
+    const ITYPE outcome_count = (ITYPE)1 << target_count;
+
+    std::vector<ITYPE> low_outcome(chunk_dim, 0);
+    for (UINT cursor = 0; cursor < target_count; ++cursor) {
+        const UINT target = target_qubit_index_list[cursor];
+        if (target >= chunk_qubit_count) continue;
+        for (ITYPE i = 0; i < chunk_dim; ++i) {
+            low_outcome[i] |= ((i >> target) & 1) << cursor;
+        }
+    }
+    std::vector<double> result(outcome_count, 0.);
+
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 10);
+#pragma omp parallel
+#endif
+    {
+        std::vector<double> histogram(outcome_count, 0.);
+        ITYPE chunk_index;
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for (chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+            const ITYPE chunk_begin = chunk_index << chunk_qubit_count;
+            ITYPE high_outcome = 0;
+            for (UINT cursor = 0; cursor < target_count; ++cursor) {
+                const UINT target = target_qubit_index_list[cursor];
+                if (target < chunk_qubit_count) continue;
+                high_outcome |= ((chunk_begin >> target) & 1) << cursor;
+            }
+            for (ITYPE i = 0; i < chunk_dim; ++i) {
+                histogram[high_outcome | low_outcome[i]] +=
+                    std::norm(std::complex<double>(state[chunk_begin + i]));
+            }
+        }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        {
+            for (ITYPE outcome = 0; outcome < outcome_count; ++outcome) {
+                result[outcome] += histogram[outcome];
+            }
+        }
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+    return result;
+}
+
+template <typename FP>
+double measurement_distribution_entropy(
+    const std::complex<FP>* state, ITYPE dim) {
+    double ent = 0;
+    const ITYPE loop_dim = dim;
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(loop_dim, 10);
+#pragma omp parallel for reduction(+ : ent)
+#endif
+    for (ITYPE state_index = 0; state_index < loop_dim; ++state_index) {
+        double prob = std::norm(std::complex<double>(state[state_index]));
+        if (prob > 0) {
+            ent -= prob * std::log(prob);
+        }
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+    return ent;
+}
+
+template double m0_prob(
+    const CTYPE* state, ITYPE dim, UINT target_qubit_index);
+template double m0_prob(
+    const CTYPE_F32* state, ITYPE dim, UINT target_qubit_index);
+template double marginal_prob(const CTYPE* state, ITYPE dim,
+    const std::vector<UINT>& sorted_target_qubit_index_list,
+    const std::vector<UINT>& measured_value_list);
+template double marginal_prob(const CTYPE_F32* state, ITYPE dim,
+    const std::vector<UINT>& sorted_target_qubit_index_list,
+    const std::vector<UINT>& measured_value_list);
+template std::vector<double> zero_probabilities(
+    const CTYPE* state, ITYPE dim);
+template std::vector<double> zero_probabilities(
+    const CTYPE_F32* state, ITYPE dim);
+template std::vector<double> marginal_distribution(const CTYPE* state,
+    ITYPE dim, const std::vector<UINT>& target_qubit_index_list);
+template std::vector<double> marginal_distribution(const CTYPE_F32* state,
+    ITYPE dim, const std::vector<UINT>& target_qubit_index_list);
+template double measurement_distribution_entropy(
+    const CTYPE* state, ITYPE dim);
+template double measurement_distribution_entropy(
+    const CTYPE_F32* state, ITYPE dim);
+}  // namespace normal
\ No newline at end of file
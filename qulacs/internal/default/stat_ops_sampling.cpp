@@ -0,0 +1,362 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#ifdef _OPENMP
+#include "../general/omp_util.hpp"
+#endif
+
+#include "../general/random.hpp"
+#include "../general/type.hpp"
+#include "stat_ops.hpp"
+
+namespace normal {
+// Blocks and chunks have a fixed size so that the summation order and the
+// random numbers, hence the result, do not depend on the number of threads.
+constexpr UINT SAMPLING_BLOCK_QUBIT_COUNT = 16;
+constexpr UINT SAMPLING_CHUNK_QUBIT_COUNT = 12;
+constexpr UINT SHUFFLE_CHUNK_QUBIT_COUNT = 16;
+constexpr ITYPE SHUFFLE_MAX_BUCKET_COUNT = 256;
+
+// Philox streams used by sampling
+constexpr uint64_t SORTED_UNIFORM_STREAM = 0;
+constexpr uint64_t SHUFFLE_BUCKET_STREAM = 1;
+constexpr uint64_t SHUFFLE_STREAM_BEGIN = 2;
+
+std::vector<double> generate_sorted_uniforms(
+    ITYPE count, double scale, UINT seed) {
+    // one more spacing than uniforms to normalize the sums
+    const ITYPE spacing_count = count + 1;
+    const ITYPE chunk_dim = (ITYPE)1 << SAMPLING_CHUNK_QUBIT_COUNT;
+    const ITYPE chunk_count = (spacing_count + chunk_dim - 1) / chunk_dim;
+    std::vector<double> uniforms(spacing_count);
+    std::vector<double> chunk_offset(chunk_count + 1, 0.);
+
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(spacing_count, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+        const ITYPE begin = chunk_index * chunk_dim;
+        const ITYPE end = std::min(begin + chunk_dim, spacing_count);
+        PhiloxEngine engine(seed, SORTED_UNIFORM_STREAM);
+        engine.set_offset(begin);
+        engine.fill_uniform(uniforms.data() + begin, end - begin);
+        double sum = 0.;
+        for (ITYPE i = begin; i < end; ++i) {
+            sum -= std::log(uniforms[i]);
+            uniforms[i] = sum;
+        }
+        chunk_offset[chunk_index + 1] = sum;
+    }
+    for (ITYPE chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+        chunk_offset[chunk_index + 1] += chunk_offset[chunk_index];
+    }
+
+    const double factor = scale / chunk_offset.back();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (ITYPE chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+        const ITYPE begin = chunk_index * chunk_dim;
+        const ITYPE end = std::min(begin + chunk_dim, spacing_count);
+        const double offset = chunk_offset[chunk_index];
+        for (ITYPE i = begin; i < end; ++i) {
+            uniforms[i] = (uniforms[i] + offset) * factor;
+        }
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+
+    uniforms.pop_back();
+    return uniforms;
+}
+
+/**
+ * Fisher-Yates shuffle of <code>samples[begin, end)</code> by the given
+ * Philox stream.
+ */
+static void shuffle_range(std::vector<ITYPE>& samples, ITYPE begin,
+    ITYPE end, UINT seed, uint64_t stream) {
+    PhiloxEngine engine(seed, stream);
+    for (ITYPE i = end - begin; i > 1; --i) {
+        std::swap(samples[begin + i - 1], samples[begin + engine() % i]);
+    }
+}
+
+// Each sample is scattered to a random bucket, then each bucket is shuffled
+// independently. The concatenation is a uniformly random permutation, and
+// both steps run in parallel.
+void shuffle_samples(std::vector<ITYPE>& samples, UINT seed) {
+    const ITYPE count = samples.size();
+    const ITYPE chunk_dim = (ITYPE)1 << SHUFFLE_CHUNK_QUBIT_COUNT;
+    const ITYPE chunk_count = (count + chunk_dim - 1) / chunk_dim;
+    const ITYPE bucket_count = std::min(chunk_count, SHUFFLE_MAX_BUCKET_COUNT);
+    if (bucket_count <= 1) {
+        shuffle_range(samples, 0, count, seed, SHUFFLE_STREAM_BEGIN);
+        return;
+    }
+
+    std::vector<ITYPE> bucket_list(count);
+    std::vector<ITYPE> position(chunk_count * bucket_count, 0);
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(count, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+        const ITYPE begin = chunk_index * chunk_dim;
+        const ITYPE end = std::min(begin + chunk_dim, count);
+        ITYPE* chunk_position = position.data() + chunk_index * bucket_count;
+        PhiloxEngine engine(seed, SHUFFLE_BUCKET_STREAM);
+        engine.set_offset(begin);
+        for (ITYPE i = begin; i < end; ++i) {
+            // multiply-shift instead of the slow modulo. bias is < 2^-24
+            bucket_list[i] = ((engine() >> 32) * bucket_count) >> 32;
+            ++chunk_position[bucket_list[i]];
+        }
+    }
+
+    // exclusive scan in the order of (bucket, chunk)
+    std::vector<ITYPE> bucket_begin(bucket_count + 1, 0);
+    ITYPE sum = 0;
+    for (ITYPE bucket = 0; bucket < bucket_count; ++bucket) {
+        bucket_begin[bucket] = sum;
+        for (ITYPE chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+            const ITYPE chunk_bucket_count =
+                position[chunk_index * bucket_count + bucket];
+            position[chunk_index * bucket_count + bucket] = sum;
+            sum += chunk_bucket_count;
+        }
+    }
+    bucket_begin[bucket_count] = sum;
+
+    std::vector<ITYPE> scattered(count);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (ITYPE chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+        const ITYPE begin = chunk_index * chunk_dim;
+        const ITYPE end = std::min(begin + chunk_dim, count);
+        ITYPE* chunk_position = position.data() + chunk_index * bucket_count;
+        for (ITYPE i = begin; i < end; ++i) {
+            scattered[chunk_position[bucket_list[i]]++] = samples[i];
+        }
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (ITYPE bucket = 0; bucket < bucket_count; ++bucket) {
+        shuffle_range(scattered, bucket_begin[bucket],
+            bucket_begin[bucket + 1], seed, SHUFFLE_STREAM_BEGIN + bucket);
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+    samples.swap(scattered);
+}
+
+template <typename FP>
+std::vector<double> sampling_block_offset(
+    const std::complex<FP>* state, ITYPE dim) {
+    const ITYPE block_dim =
+        std::min(dim, (ITYPE)1 << SAMPLING_BLOCK_QUBIT_COUNT);
+    const ITYPE block_count = dim / block_dim;
+    std::vector<double> block_offset(block_count + 1, 0.);
+
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 10);
+#pragma omp parallel for
+#endif
+    for (ITYPE block_index = 0; block_index < block_count; ++block_index) {
+        const std::complex<FP>* block = state + block_index * block_dim;
+        double sum = 0.;
+        for (ITYPE i = 0; i < block_dim; ++i) {
+            sum += std::norm(std::complex<double>(block[i]));
+        }
+        block_offset[block_index + 1] = sum;
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+    for (ITYPE block_index = 0; block_index < block_count; ++block_index) {
+        block_offset[block_index + 1] += block_offset[block_index];
+    }
+    return block_offset;
+}
+
+template <typename FP>
+void sample_sorted_uniforms(const std::complex<FP>* state, ITYPE dim,
+    const std::vector<double>& block_offset, const double* uniforms,
+    ITYPE count, double uniform_offset, ITYPE* samples) {
+    const ITYPE block_count = block_offset.size() - 1;
+    const ITYPE block_dim = dim / block_count;
+    const double* uniforms_end = uniforms + count;
+
+    // each block assigns itself the uniforms in its range in a single sweep
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 10);
+#pragma omp parallel for
+#endif
+    for (ITYPE block_index = 0; block_index < block_count; ++block_index) {
+        const double offset = uniform_offset + block_offset[block_index];
+        ITYPE j = std::lower_bound(uniforms, uniforms_end, offset) - uniforms;
+        const ITYPE end =
+            (block_index + 1 == block_count)
+                ? count
+                : std::lower_bound(uniforms, uniforms_end,
+                      uniform_offset + block_offset[block_index + 1]) -
+                      uniforms;
+        if (j == end) continue;
+
+        const ITYPE block_begin = block_index * block_dim;
+        ITYPE last_nonzero_index = block_begin;
+        double sum = 0.;
+        for (ITYPE i = block_begin; i < block_begin + block_dim; ++i) {
+            const double prob = std::norm(std::complex<double>(state[i]));
+            if (prob > 0.) last_nonzero_index = i;
+            sum += prob;
+            while (j < end && uniforms[j] - offset < sum) {
+                samples[j++] = i;
+            }
+        }
+        // uniforms left by rounding error
+        while (j < end) {
+            samples[j++] = last_nonzero_index;
+        }
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template <typename FP>
+std::vector<ITYPE> sampling(const std::complex<FP>* state, ITYPE dim,
+    UINT sampling_count, UINT seed) {
+    const std::vector<double> block_offset =
+        sampling_block_offset(state, dim);
+    const std::vector<double> uniforms =
+        generate_sorted_uniforms(sampling_count, block_offset.back(), seed);
+    std::vector<ITYPE> samples(sampling_count);
+    sample_sorted_uniforms(state, dim, block_offset, uniforms.data(),
+        sampling_count, 0., samples.data());
+    shuffle_samples(samples, seed);
+    return samples;
+}
+
+template <typename FP>
+void cumulative_probability(
+    const std::complex<FP>* state, ITYPE dim, double* cumulative) {
+    const ITYPE block_dim =
+        std::min(dim, (ITYPE)1 << SAMPLING_BLOCK_QUBIT_COUNT);
+    const ITYPE block_count = dim / block_dim;
+
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 10);
+#pragma omp parallel for
+#endif
+    for (ITYPE block_index = 0; block_index < block_count; ++block_index) {
+        const ITYPE block_begin = block_index * block_dim;
+        double sum = 0.;
+        for (ITYPE i = block_begin; i < block_begin + block_dim; ++i) {
+            sum += std::norm(std::complex<double>(state[i]));
+            cumulative[i] = sum;
+        }
+    }
+
+    std::vector<double> block_offset(block_count, 0.);
+    for (ITYPE block_index = 1; block_index < block_count; ++block_index) {
+        block_offset[block_index] = block_offset[block_index - 1] +
+                                    cumulative[block_index * block_dim - 1];
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (ITYPE block_index = 1; block_index < block_count; ++block_index) {
+        const ITYPE block_begin = block_index * block_dim;
+        const double offset = block_offset[block_index];
+        for (ITYPE i = block_begin; i < block_begin + block_dim; ++i) {
+            cumulative[i] += offset;
+        }
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+/**
+ * Find the first index not less than <code>index</code> whose cumulative
+ * probability exceeds <code>value</code>, galloping from <code>index</code>.
+ */
+inline static ITYPE gallop_upper_bound(
+    const double* cumulative, ITYPE dim, ITYPE index, double value) {
+    ITYPE low = index, high = index, step = 1;
+    while (high < dim && cumulative[high] <= value) {
+        low = high + 1;
+        high += step;
+        step *= 2;
+    }
+    return std::upper_bound(
+               cumulative + low, cumulative + std::min(high, dim), value) -
+           cumulative;
+}
+
+std::vector<ITYPE> sampling_from_cumulative_probability(
+    const double* cumulative, ITYPE dim, UINT sampling_count, UINT seed) {
+    ITYPE last_nonzero_index = dim - 1;
+    while (last_nonzero_index > 0 &&
+           cumulative[last_nonzero_index] ==
+               cumulative[last_nonzero_index - 1]) {
+        --last_nonzero_index;
+    }
+
+    const std::vector<double> uniforms =
+        generate_sorted_uniforms(sampling_count, cumulative[dim - 1], seed);
+    std::vector<ITYPE> samples(sampling_count);
+
+    // merge a chunk of sorted uniforms with the table. galloping keeps it
+    // O(log dim) per shot for few shots and O(dim + shots) for many shots
+    const ITYPE chunk_dim = (ITYPE)1 << SAMPLING_CHUNK_QUBIT_COUNT;
+    const ITYPE chunk_count = (sampling_count + chunk_dim - 1) / chunk_dim;
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(sampling_count, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+        const ITYPE chunk_end =
+            std::min((chunk_index + 1) * chunk_dim, (ITYPE)sampling_count);
+        ITYPE index = 0;
+        for (ITYPE j = chunk_index * chunk_dim; j < chunk_end; ++j) {
+            index = gallop_upper_bound(cumulative, dim, index, uniforms[j]);
+            samples[j] = std::min(index, last_nonzero_index);
+        }
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+
+    shuffle_samples(samples, seed);
+    return samples;
+}
+
+template std::vector<double> sampling_block_offset(
+    const CTYPE* state, ITYPE dim);
+template std::vector<double> sampling_block_offset(
+    const CTYPE_F32* state, ITYPE dim);
+template void sample_sorted_uniforms(const CTYPE* state, ITYPE dim,
+    const std::vector<double>& block_offset, const double* uniforms,
+    ITYPE count, double uniform_offset, ITYPE* samples);
+template void sample_sorted_uniforms(const CTYPE_F32* state, ITYPE dim,
+    const std::vector<double>& block_offset, const double* uniforms,
+    ITYPE count, double uniform_offset, ITYPE* samples);
+template std::vector<ITYPE> sampling(
+    const CTYPE* state, ITYPE dim, UINT sampling_count, UINT seed);
+template std::vector<ITYPE> sampling(
+    const CTYPE_F32* state, ITYPE dim, UINT sampling_count, UINT seed);
+template void cumulative_probability(
+    const CTYPE* state, ITYPE dim, double* cumulative);
+template void cumulative_probability(
+    const CTYPE_F32* state, ITYPE dim, double* cumulative);
+}  // namespace normal
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <vector>
+
+#ifdef _OPENMP
+#include "../general/omp_util.hpp"
+#endif
+#include "state_ops.hpp"
+
+namespace normal {
+constexpr UINT INNER_PRODUCT_BLOCK_QUBIT_COUNT = 12;
+// The output of tensor_product is written in blocks of up to 2^12 basis
+// that share one amplitude of state_left.
+constexpr UINT TENSOR_PRODUCT_BLOCK_QUBIT_COUNT = 12;
+
+inline static void kahan_add(double& sum, double& compensation, double value) {
+    const double y = value - compensation;
+    const double t = sum + y;
+    compensation = (t - sum) - y;
+    sum = t;
+}
+
+template <typename FP>
+CTYPE inner_product(const std::complex<FP>* state_bra,
+    const std::complex<FP>* state_ket, ITYPE dim) {
+    const ITYPE block_dim =
+        std::min(dim, (ITYPE)1 << INNER_PRODUCT_BLOCK_QUBIT_COUNT);
+    const ITYPE block_count = dim / block_dim;
+    std::vector<double> real_list(block_count), imag_list(block_count);
+
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 10);
+#pragma omp parallel for
+#endif
+    for (ITYPE block_index = 0; block_index < block_count; ++block_index) {
+        const ITYPE block_begin = block_index * block_dim;
+        double real = 0., real_compensation = 0.;
+        double imag = 0., imag_compensation = 0.;
+        for (ITYPE i = block_begin; i < block_begin + block_dim; ++i) {
+            const double ar = state_bra[i].real(), ai = state_bra[i].imag();
+            const double br = state_ket[i].real(), bi = state_ket[i].imag();
+            kahan_add(real, real_compensation, ar * br + ai * bi);
+            kahan_add(imag, imag_compensation, ar * bi - ai * br);
+        }
+        real_list[block_index] = real;
+        imag_list[block_index] = imag;
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+
+    double real = 0., real_compensation = 0.;
+    double imag = 0., imag_compensation = 0.;
+    for (ITYPE block_index = 0; block_index < block_count; ++block_index) {
+        kahan_add(real, real_compensation, real_list[block_index]);
+        kahan_add(imag, imag_compensation, imag_list[block_index]);
+    }
+    return CTYPE(real, imag);
+}
+
+template <typename FP>
+void add_with_coef(CTYPE coef1, const std::complex<FP>* state1, CTYPE coef2,
+    const std::complex<FP>* state2, std::complex<FP>* state_out, ITYPE dim) {
+    // complex products are written out so that the loop is vectorized
+    const double c1r = coef1.real(), c1i = coef1.imag();
+    const double c2r = coef2.real(), c2i = coef2.imag();
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE i = 0; i < dim; ++i) {
+        const double ar = state1[i].real(), ai = state1[i].imag();
+        const double br = state2[i].real(), bi = state2[i].imag();
+        state_out[i] = std::complex<FP>(
+            (FP)(c1r * ar - c1i * ai + c2r * br - c2i * bi),
+            (FP)(c1r * ai + c1i * ar + c2r * bi + c2i * br));
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template <typename FP>
+void tensor_product(const std::complex<FP>* state_left, ITYPE dim_left,
+    const std::complex<FP>* state_right, ITYPE dim_right,
+    std::complex<FP>* state_out) {
+    const ITYPE dim = dim_left * dim_right;
+    const ITYPE block_dim =
+        std::min(dim_right, (ITYPE)1 << TENSOR_PRODUCT_BLOCK_QUBIT_COUNT);
+    const ITYPE block_count = dim / block_dim;
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE block_index = 0; block_index < block_count; ++block_index) {
+        const ITYPE block_begin = block_index * block_dim;
+        const std::complex<FP> left = state_left[block_begin / dim_right];
+        const std::complex<FP>* right = state_right + block_begin % dim_right;
+        std::complex<FP>* out = state_out + block_begin;
+        const FP lr = left.real(), li = left.imag();
+        for (ITYPE i = 0; i < block_dim; ++i) {
+            const FP rr = right[i].real(), ri = right[i].imag();
+            out[i] = std::complex<FP>(lr * rr - li * ri, lr * ri + li * rr);
+        }
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template CTYPE inner_product(
+    const CTYPE* state_bra, const CTYPE* state_ket, ITYPE dim);
+template CTYPE inner_product(
+    const CTYPE_F32* state_bra, const CTYPE_F32* state_ket, ITYPE dim);
+template void add_with_coef(CTYPE coef1, const CTYPE* state1, CTYPE coef2,
+    const CTYPE* state2, CTYPE* state_out, ITYPE dim);
+template void add_with_coef(CTYPE coef1, const CTYPE_F32* state1,
+    CTYPE coef2, const CTYPE_F32* state2, CTYPE_F32* state_out, ITYPE dim);
+template void tensor_product(const CTYPE* state_left, ITYPE dim_left,
+    const CTYPE* state_right, ITYPE dim_right, CTYPE* state_out);
+template void tensor_product(const CTYPE_F32* state_left, ITYPE dim_left,
+    const CTYPE_F32* state_right, ITYPE dim_right, CTYPE_F32* state_out);
+}  // namespace normal
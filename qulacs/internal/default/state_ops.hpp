@@ -0,0 +1,69 @@
+/**
+ * @file state_ops.hpp
+ * @brief functions of combining state vectors
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "../general/type.hpp"
+
+namespace normal {
+/**
+ * Compute <bra|ket>.
+ *
+ * Each block of 2^12 basis is summed with Kahan compensation, and the block
+ * sums are combined in a fixed order with Kahan compensation, so the result
+ * does not depend on the number of threads.
+ */
+template <typename FP>
+DllExport CTYPE inner_product(const std::complex<FP>* state_bra,
+    const std::complex<FP>* state_ket, ITYPE dim);
+
+/**
+ * Write coef1 * state1 + coef2 * state2 to <code>state_out</code>.
+ * <code>state_out</code> may be the same as <code>state1</code> or
+ * <code>state2</code>.
+ */
+template <typename FP>
+DllExport void add_with_coef(CTYPE coef1, const std::complex<FP>* state1,
+    CTYPE coef2, const std::complex<FP>* state2, std::complex<FP>* state_out,
+    ITYPE dim);
+
+/**
+ * Write the tensor product of <code>state_left</code> (upper qubits) and
+ * <code>state_right</code> (lower qubits) to <code>state_out</code> of
+ * length dim_left * dim_right.
+ */
+template <typename FP>
+DllExport void tensor_product(const std::complex<FP>* state_left,
+    ITYPE dim_left, const std::complex<FP>* state_right, ITYPE dim_right,
+    std::complex<FP>* state_out);
+
+/**
+ * Write the state with permutated qubits to <code>state_dst</code>.
+ * Qubit q of <code>state_dst</code> is qubit <code>qubit_order[q]</code> of
+ * <code>state_src</code>.
+ *
+ * The state is copied tile by tile, where a tile is spanned by the low
+ * qubits of both sides, so that reads and writes use whole cache lines
+ * regardless of the permutation.
+ */
+template <typename FP>
+DllExport void permutate_qubit(const std::complex<FP>* state_src,
+    std::complex<FP>* state_dst, const std::vector<UINT>& qubit_order,
+    ITYPE dim);
+
+/**
+ * Write the amplitudes of <code>state_src</code> whose target qubits have
+ * the values <code>projection_list</code> to <code>state_dst</code> of
+ * length dim >> k, removing the target qubits. The result is not
+ * normalized.
+ */
+template <typename FP>
+DllExport void drop_qubit(const std::complex<FP>* state_src,
+    std::complex<FP>* state_dst,
+    const std::vector<UINT>& sorted_target_qubit_index_list,
+    const std::vector<UINT>& projection_list, ITYPE dim);
+}  // namespace normal
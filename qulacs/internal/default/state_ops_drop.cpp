@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <vector>
+
+#include "../general/number_util.hpp"
+#ifdef _OPENMP
+#include "../general/omp_util.hpp"
+#endif
+#include "state_ops.hpp"
+
+namespace normal {
+// Amplitudes below the lowest dropped qubit are consecutive in both states,
+// so they are copied in runs of up to 2^12 basis.
+constexpr UINT DROP_RUN_QUBIT_COUNT = 12;
+
+template <typename FP>
+void drop_qubit(const std::complex<FP>* state_src,
+    std::complex<FP>* state_dst,
+    const std::vector<UINT>& sorted_target_qubit_index_list,
+    const std::vector<UINT>& projection_list, ITYPE dim) {
+    const std::vector<ITYPE> insert_mask_list =
+        create_insert_zero_mask_list(sorted_target_qubit_index_list);
+    ITYPE fixed_value = 0;
+    for (UINT cursor = 0; cursor < sorted_target_qubit_index_list.size();
+         ++cursor) {
+        fixed_value |= (ITYPE)projection_list[cursor]
+                       << sorted_target_qubit_index_list[cursor];
+    }
+    const ITYPE dst_dim = dim >> sorted_target_qubit_index_list.size();
+    UINT run_qubit_count = DROP_RUN_QUBIT_COUNT;
+    while (((ITYPE)1 << run_qubit_count) > dst_dim) --run_qubit_count;
+    if (!sorted_target_qubit_index_list.empty()) {
+        run_qubit_count =
+            std::min(run_qubit_count, sorted_target_qubit_index_list[0]);
+    }
+    const ITYPE run_dim = (ITYPE)1 << run_qubit_count;
+    const ITYPE run_count = dst_dim >> run_qubit_count;
+
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE run_index = 0; run_index < run_count; ++run_index) {
+        const ITYPE dst_begin = run_index << run_qubit_count;
+        // the inserted bits are all above the run
+        const ITYPE src_begin =
+            insert_zeros_to_basis_index(dst_begin, insert_mask_list) |
+            fixed_value;
+        std::copy(state_src + src_begin, state_src + src_begin + run_dim,
+            state_dst + dst_begin);
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template void drop_qubit(const CTYPE* state_src, CTYPE* state_dst,
+    const std::vector<UINT>& sorted_target_qubit_index_list,
+    const std::vector<UINT>& projection_list, ITYPE dim);
+template void drop_qubit(const CTYPE_F32* state_src, CTYPE_F32* state_dst,
+    const std::vector<UINT>& sorted_target_qubit_index_list,
+    const std::vector<UINT>& projection_list, ITYPE dim);
+}  // namespace normal
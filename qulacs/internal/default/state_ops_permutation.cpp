@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <vector>
+
+#include "../general/number_util.hpp"
+#ifdef _OPENMP
+#include "../general/omp_util.hpp"
+#endif
+#include "state_ops.hpp"
+
+namespace normal {
+// Both the source and the destination are read and written in runs of 2^5
+// consecutive basis, i.e. several cache lines at once.
+constexpr UINT PERMUTATION_RUN_QUBIT_COUNT = 5;
+
+// Move bit q of dst_index to bit qubit_order[q].
+inline static ITYPE permutate_basis_index(
+    ITYPE dst_index, const std::vector<UINT>& qubit_order) {
+    ITYPE src_index = 0;
+    for (UINT qubit = 0; qubit < qubit_order.size(); ++qubit) {
+        src_index |= ((dst_index >> qubit) & 1) << qubit_order[qubit];
+    }
+    return src_index;
+}
+
+// Scatter the low bits of value to the set bits of mask.
+inline static ITYPE deposit_bits(ITYPE value, ITYPE mask) {
+    ITYPE result = 0;
+    for (; mask != 0; mask &= mask - 1, value >>= 1) {
+        if (value & 1) result |= mask & (~mask + 1);
+    }
+    return result;
+}
+
+template <typename FP>
+void permutate_qubit(const std::complex<FP>* state_src,
+    std::complex<FP>* state_dst, const std::vector<UINT>& qubit_order,
+    ITYPE dim) {
+    const UINT qubit_count = qubit_order.size();
+    const UINT run_qubit_count =
+        std::min(qubit_count, PERMUTATION_RUN_QUBIT_COUNT);
+
+    // A tile is spanned by the low qubits of the destination and the qubits
+    // that become the low qubits of the source, so every cache line it
+    // touches on either side is used entirely within the tile.
+    ITYPE tile_mask = ((ITYPE)1 << run_qubit_count) - 1;
+    for (UINT qubit = 0; qubit < qubit_count; ++qubit) {
+        if (qubit_order[qubit] < run_qubit_count) {
+            tile_mask |= (ITYPE)1 << qubit;
+        }
+    }
+    std::vector<UINT> tile_qubit_list;
+    for (UINT qubit = 0; qubit < qubit_count; ++qubit) {
+        if ((tile_mask >> qubit) & 1) tile_qubit_list.push_back(qubit);
+    }
+    const ITYPE tile_dim = (ITYPE)1 << tile_qubit_list.size();
+    const ITYPE tile_count = dim / tile_dim;
+    const std::vector<ITYPE> insert_mask_list =
+        create_insert_zero_mask_list(tile_qubit_list);
+
+    // the low bits of the index in a tile are the low qubits of the
+    // destination, so the innermost run is written consecutively
+    std::vector<ITYPE> tile_dst_list(tile_dim), tile_src_list(tile_dim);
+    for (ITYPE i = 0; i < tile_dim; ++i) {
+        tile_dst_list[i] = deposit_bits(i, tile_mask);
+        tile_src_list[i] = permutate_basis_index(tile_dst_list[i], qubit_order);
+    }
+
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE tile_index = 0; tile_index < tile_count; ++tile_index) {
+        const ITYPE dst_base =
+            insert_zeros_to_basis_index(tile_index, insert_mask_list);
+        const ITYPE src_base = permutate_basis_index(dst_base, qubit_order);
+        for (ITYPE i = 0; i < tile_dim; ++i) {
+            state_dst[dst_base | tile_dst_list[i]] =
+                state_src[src_base | tile_src_list[i]];
+        }
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template void permutate_qubit(const CTYPE* state_src, CTYPE* state_dst,
+    const std::vector<UINT>& qubit_order, ITYPE dim);
+template void permutate_qubit(const CTYPE_F32* state_src,
+    CTYPE_F32* state_dst, const std::vector<UINT>& qubit_order, ITYPE dim);
+}  // namespace normal
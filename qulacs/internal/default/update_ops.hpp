@@ -10,5 +10,119 @@
 #include "../general/type.hpp"
 
 namespace normal {
-DllExport void normalize(const std::vector<CTYPE>& state, double norm);
-}
\ No newline at end of file
+template <typename FP>
+DllExport void normalize(std::complex<FP>* state, ITYPE dim, double norm);
+
+/**
+ * Set the amplitudes whose bits in <code>mask</code> differ from
+ * <code>value</code> to 0 and divide the others by sqrt(norm), in a single
+ * sweep.
+ */
+template <typename FP>
+DllExport void project_and_normalize(ITYPE mask, ITYPE value, double norm,
+    std::complex<FP>* state, ITYPE dim);
+
+/**
+ * Apply 2x2 dense matrix to the target qubit.
+ *
+ * @param[in] target_qubit_index index of the target qubit
+ * @param[in] matrix 2x2 matrix in row-major order
+ * @param[in,out] state state vector
+ */
+template <typename FP>
+DllExport void single_qubit_dense_matrix_gate(UINT target_qubit_index,
+    const CTYPE matrix[4], std::complex<FP>* state, ITYPE dim);
+
+/**
+ * Apply 2^k x 2^k dense matrix to k target qubits.
+ *
+ * The i-th bit of the matrix index corresponds to
+ * <code>target_qubit_index_list[i]</code>.
+ *
+ * @param[in] target_qubit_index_list indices of the target qubits
+ * @param[in] matrix 2^k x 2^k matrix in row-major order
+ * @param[in,out] state state vector
+ */
+template <typename FP>
+DllExport void multi_qubit_dense_matrix_gate(
+    const std::vector<UINT>& target_qubit_index_list,
+    const std::vector<CTYPE>& matrix, std::complex<FP>* state, ITYPE dim);
+
+/**
+ * Apply 2^k x 2^k dense matrix to k target qubits only on the amplitudes
+ * whose control qubits have the given values.
+ *
+ * @param[in] control_qubit_index_list indices of the control qubits
+ * @param[in] control_value_list values (0 or 1) of the control qubits
+ * @param[in] target_qubit_index_list indices of the target qubits
+ * @param[in] matrix 2^k x 2^k matrix in row-major order
+ * @param[in,out] state state vector
+ */
+template <typename FP>
+DllExport void multi_qubit_control_multi_qubit_dense_matrix_gate(
+    const std::vector<UINT>& control_qubit_index_list,
+    const std::vector<UINT>& control_value_list,
+    const std::vector<UINT>& target_qubit_index_list,
+    const std::vector<CTYPE>& matrix, std::complex<FP>* state, ITYPE dim);
+
+/**
+ * Apply 2x2 diagonal matrix to the target qubit in a single sweep.
+ *
+ * @param[in] target_qubit_index index of the target qubit
+ * @param[in] diagonal_matrix diagonal elements
+ * @param[in,out] state state vector
+ */
+template <typename FP>
+DllExport void single_qubit_diagonal_matrix_gate(UINT target_qubit_index,
+    const CTYPE diagonal_matrix[2], std::complex<FP>* state, ITYPE dim);
+
+/**
+ * Multiply <code>phase</code> to the amplitudes whose target bit is 1.
+ */
+template <typename FP>
+DllExport void single_qubit_phase_gate(UINT target_qubit_index, CTYPE phase,
+    std::complex<FP>* state, ITYPE dim);
+
+template <typename FP>
+DllExport void X_gate(
+    UINT target_qubit_index, std::complex<FP>* state, ITYPE dim);
+template <typename FP>
+DllExport void Y_gate(
+    UINT target_qubit_index, std::complex<FP>* state, ITYPE dim);
+template <typename FP>
+DllExport void Z_gate(
+    UINT target_qubit_index, std::complex<FP>* state, ITYPE dim);
+template <typename FP>
+DllExport void S_gate(
+    UINT target_qubit_index, std::complex<FP>* state, ITYPE dim);
+template <typename FP>
+DllExport void Sdag_gate(
+    UINT target_qubit_index, std::complex<FP>* state, ITYPE dim);
+template <typename FP>
+DllExport void T_gate(
+    UINT target_qubit_index, std::complex<FP>* state, ITYPE dim);
+template <typename FP>
+DllExport void Tdag_gate(
+    UINT target_qubit_index, std::complex<FP>* state, ITYPE dim);
+template <typename FP>
+DllExport void P0_gate(
+    UINT target_qubit_index, std::complex<FP>* state, ITYPE dim);
+template <typename FP>
+DllExport void P1_gate(
+    UINT target_qubit_index, std::complex<FP>* state, ITYPE dim);
+
+/**
+ * Swap two qubits in place. Only the amplitudes whose two target bits
+ * differ are exchanged, so no buffer is needed.
+ */
+template <typename FP>
+DllExport void SWAP_gate(UINT target_qubit_index_0, UINT target_qubit_index_1,
+    std::complex<FP>* state, ITYPE dim);
+
+/**
+ * Apply exp(-i angle Z / 2) to the target qubit.
+ */
+template <typename FP>
+DllExport void RZ_gate(UINT target_qubit_index, double angle,
+    std::complex<FP>* state, ITYPE dim);
+}  // namespace normal
@@ -0,0 +1,188 @@
+#include <vector>
+
+#ifdef _OPENMP
+#include "../general/omp_util.hpp"
+#endif
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+#include "../general/number_util.hpp"
+#include "../general/type.hpp"
+#include "update_ops.hpp"
+
+namespace normal {
+/**
+ * Precomputed index masks shared by the multi-qubit kernels.
+ */
+struct IndexMaskInfo {
+    std::vector<ITYPE> insert_mask_list;  // lower masks of fixed bits
+    ITYPE free_mask;     // bits that are neither target nor control
+    ITYPE control_mask;  // control values placed on control bits
+    std::vector<ITYPE> target_offset_list;  // offset of each matrix index
+};
+
+static IndexMaskInfo create_index_mask_info(
+    const std::vector<UINT>& control_qubit_index_list,
+    const std::vector<UINT>& control_value_list,
+    const std::vector<UINT>& target_qubit_index_list, ITYPE dim) {
+    IndexMaskInfo info;
+    std::vector<UINT> fixed_qubit_index_list = target_qubit_index_list;
+    fixed_qubit_index_list.insert(fixed_qubit_index_list.end(),
+        control_qubit_index_list.begin(), control_qubit_index_list.end());
+    info.insert_mask_list =
+        create_insert_zero_mask_list(fixed_qubit_index_list);
+
+    ITYPE fixed_mask = 0;
+    for (UINT qubit_index : fixed_qubit_index_list) {
+        fixed_mask |= 1ULL << qubit_index;
+    }
+    info.free_mask = (dim - 1) & ~fixed_mask;
+
+    info.control_mask = 0;
+    for (UINT i = 0; i < control_qubit_index_list.size(); ++i) {
+        info.control_mask |= (ITYPE)control_value_list[i]
+                             << control_qubit_index_list[i];
+    }
+
+    const ITYPE matrix_dim = 1ULL << target_qubit_index_list.size();
+    info.target_offset_list.assign(matrix_dim, 0);
+    for (ITYPE j = 0; j < matrix_dim; ++j) {
+        for (UINT i = 0; i < target_qubit_index_list.size(); ++i) {
+            if ((j >> i) & 1) {
+                info.target_offset_list[j] |= 1ULL
+                                              << target_qubit_index_list[i];
+            }
+        }
+    }
+    return info;
+}
+
+/**
+ * Scatter the bits of <code>state_index</code> to the free bit positions.
+ */
+inline static ITYPE deposit_basis_index(
+    ITYPE state_index, const IndexMaskInfo& info) {
+#ifdef __BMI2__
+    return _pdep_u64(state_index, info.free_mask);
+#else
+    return insert_zeros_to_basis_index(state_index, info.insert_mask_list);
+#endif
+}
+
+template <typename FP>
+static void multi_qubit_control_single_qubit_dense_matrix_gate(
+    const IndexMaskInfo& info, const CTYPE matrix[4],
+    std::complex<FP>* state, ITYPE loop_dim) {
+    const std::complex<FP> m0(matrix[0]), m1(matrix[1]), m2(matrix[2]),
+        m3(matrix[3]);
+    const ITYPE target_mask = info.target_offset_list[1];
+    ITYPE state_index;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (state_index = 0; state_index < loop_dim; ++state_index) {
+        ITYPE basis_0 = deposit_basis_index(state_index, info) |
+                        info.control_mask;
+        ITYPE basis_1 = basis_0 | target_mask;
+        std::complex<FP> cval_0 = state[basis_0];
+        std::complex<FP> cval_1 = state[basis_1];
+        state[basis_0] = m0 * cval_0 + m1 * cval_1;
+        state[basis_1] = m2 * cval_0 + m3 * cval_1;
+    }
+}
+
+template <typename FP>
+static void multi_qubit_control_multi_qubit_dense_matrix_gate_parallel(
+    const IndexMaskInfo& info, const std::vector<CTYPE>& matrix,
+    std::complex<FP>* state, ITYPE loop_dim) {
+    const ITYPE matrix_dim = info.target_offset_list.size();
+    const std::vector<std::complex<FP>> matrix_fp(matrix.begin(), matrix.end());
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<std::complex<FP>> buffer(matrix_dim);
+        ITYPE state_index;
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for (state_index = 0; state_index < loop_dim; ++state_index) {
+            ITYPE basis_0 = deposit_basis_index(state_index, info) |
+                            info.control_mask;
+            for (ITYPE y = 0; y < matrix_dim; ++y) {
+                std::complex<FP> sum = 0.;
+                const std::complex<FP>* row = matrix_fp.data() + y * matrix_dim;
+                for (ITYPE x = 0; x < matrix_dim; ++x) {
+                    sum +=
+                        row[x] * state[basis_0 ^ info.target_offset_list[x]];
+                }
+                buffer[y] = sum;
+            }
+            for (ITYPE y = 0; y < matrix_dim; ++y) {
+                state[basis_0 ^ info.target_offset_list[y]] = buffer[y];
+            }
+        }
+    }
+}
+
+template <typename FP>
+void multi_qubit_control_multi_qubit_dense_matrix_gate(
+    const std::vector<UINT>& control_qubit_index_list,
+    const std::vector<UINT>& control_value_list,
+    const std::vector<UINT>& target_qubit_index_list,
+    const std::vector<CTYPE>& matrix, std::complex<FP>* state, ITYPE dim) {
+    if (control_qubit_index_list.empty() &&
+        target_qubit_index_list.size() == 1) {
+        single_qubit_dense_matrix_gate(
+            target_qubit_index_list[0], matrix.data(), state, dim);
+        return;
+    }
+
+    const IndexMaskInfo info = create_index_mask_info(control_qubit_index_list,
+        control_value_list, target_qubit_index_list, dim);
+    const ITYPE loop_dim = dim >> (control_qubit_index_list.size() +
+                                      target_qubit_index_list.size());
+
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#endif
+
+    if (target_qubit_index_list.size() == 1) {
+        multi_qubit_control_single_qubit_dense_matrix_gate(
+            info, matrix.data(), state, loop_dim);
+    } else {
+        multi_qubit_control_multi_qubit_dense_matrix_gate_parallel(
+            info, matrix, state, loop_dim);
+    }
+
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template <typename FP>
+void multi_qubit_dense_matrix_gate(
+    const std::vector<UINT>& target_qubit_index_list,
+    const std::vector<CTYPE>& matrix, std::complex<FP>* state, ITYPE dim) {
+    multi_qubit_control_multi_qubit_dense_matrix_gate(
+        {}, {}, target_qubit_index_list, matrix, state, dim);
+}
+
+template void multi_qubit_control_multi_qubit_dense_matrix_gate(
+    const std::vector<UINT>& control_qubit_index_list,
+    const std::vector<UINT>& control_value_list,
+    const std::vector<UINT>& target_qubit_index_list,
+    const std::vector<CTYPE>& matrix, CTYPE* state, ITYPE dim);
+template void multi_qubit_control_multi_qubit_dense_matrix_gate(
+    const std::vector<UINT>& control_qubit_index_list,
+    const std::vector<UINT>& control_value_list,
+    const std::vector<UINT>& target_qubit_index_list,
+    const std::vector<CTYPE>& matrix, CTYPE_F32* state, ITYPE dim);
+template void multi_qubit_dense_matrix_gate(
+    const std::vector<UINT>& target_qubit_index_list,
+    const std::vector<CTYPE>& matrix, CTYPE* state, ITYPE dim);
+template void multi_qubit_dense_matrix_gate(
+    const std::vector<UINT>& target_qubit_index_list,
+    const std::vector<CTYPE>& matrix, CTYPE_F32* state, ITYPE dim);
+}  // namespace normal
@@ -0,0 +1,246 @@
+#include <type_traits>
+#include <vector>
+
+#ifdef _OPENMP
+#include "../general/omp_util.hpp"
+#endif
+#ifdef _USE_SIMD
+#include <immintrin.h>
+#endif
+
+#include "../general/number_util.hpp"
+#include "../general/type.hpp"
+#include "update_ops.hpp"
+
+namespace normal {
+template <typename FP>
+void single_qubit_dense_matrix_gate_parallel(UINT target_qubit_index,
+    const CTYPE matrix[4], std::complex<FP>* state, ITYPE dim);
+#ifdef _USE_SIMD
+void single_qubit_dense_matrix_gate_parallel_simd(
+    UINT target_qubit_index, const CTYPE matrix[4], CTYPE* state, ITYPE dim);
+#endif
+#ifdef __AVX512F__
+void single_qubit_dense_matrix_gate_parallel_avx512(
+    UINT target_qubit_index, const CTYPE matrix[4], CTYPE* state, ITYPE dim);
+#endif
+
+template <typename FP>
+void single_qubit_dense_matrix_gate(UINT target_qubit_index,
+    const CTYPE matrix[4], std::complex<FP>* state, ITYPE dim) {
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#endif
+
+    if constexpr (!std::is_same_v<FP, double>) {
+        // SIMD kernels are specialized to double precision
+        single_qubit_dense_matrix_gate_parallel(
+            target_qubit_index, matrix, state, dim);
+    } else {
+#if defined(__AVX512F__)
+        if (dim >= 8) {
+            single_qubit_dense_matrix_gate_parallel_avx512(
+                target_qubit_index, matrix, state, dim);
+        } else {
+            single_qubit_dense_matrix_gate_parallel(
+                target_qubit_index, matrix, state, dim);
+        }
+#elif defined(_USE_SIMD)
+        if (dim >= 4) {
+            single_qubit_dense_matrix_gate_parallel_simd(
+                target_qubit_index, matrix, state, dim);
+        } else {
+            single_qubit_dense_matrix_gate_parallel(
+                target_qubit_index, matrix, state, dim);
+        }
+#else
+        single_qubit_dense_matrix_gate_parallel(
+            target_qubit_index, matrix, state, dim);
+#endif
+    }
+
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template <typename FP>
+void single_qubit_dense_matrix_gate_parallel(UINT target_qubit_index,
+    const CTYPE matrix[4], std::complex<FP>* state, ITYPE dim) {
+    const std::complex<FP> m0(matrix[0]), m1(matrix[1]), m2(matrix[2]),
+        m3(matrix[3]);
+    const ITYPE loop_dim = dim / 2;
+    const ITYPE mask = 1ULL << target_qubit_index;
+    ITYPE state_index;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (state_index = 0; state_index < loop_dim; ++state_index) {
+        ITYPE basis_0 =
+            insert_zero_to_basis_index(state_index, target_qubit_index);
+        ITYPE basis_1 = basis_0 | mask;
+        std::complex<FP> cval_0 = state[basis_0];
+        std::complex<FP> cval_1 = state[basis_1];
+        state[basis_0] = m0 * cval_0 + m1 * cval_1;
+        state[basis_1] = m2 * cval_0 + m3 * cval_1;
+    }
+}
+
+#ifdef _USE_SIMD
+/**
+ * Multiply packed complex values. <code>coef_re</code> and
+ * <code>coef_im</code> hold the real and imaginary part of the coefficient
+ * duplicated on both lanes of each complex value.
+ */
+inline static __m256d complex_mul_256(
+    __m256d coef_re, __m256d coef_im, __m256d vec) {
+    __m256d vec_swap = _mm256_permute_pd(vec, 0b0101);
+    return _mm256_fmaddsub_pd(coef_re, vec, _mm256_mul_pd(coef_im, vec_swap));
+}
+
+void single_qubit_dense_matrix_gate_parallel_simd(
+    UINT target_qubit_index, const CTYPE matrix[4], CTYPE* state, ITYPE dim) {
+    double* ptr = reinterpret_cast<double*>(state);
+    const ITYPE mask = 1ULL << target_qubit_index;
+    ITYPE state_index;
+    if (target_qubit_index == 0) {
+        // one register holds the pair (basis_0, basis_1).
+        // new[j] = diag[j] * val[j] + off[j] * val[j ^ 1]
+        const __m256d diag_re = _mm256_setr_pd(matrix[0].real(),
+            matrix[0].real(), matrix[3].real(), matrix[3].real());
+        const __m256d diag_im = _mm256_setr_pd(matrix[0].imag(),
+            matrix[0].imag(), matrix[3].imag(), matrix[3].imag());
+        const __m256d off_re = _mm256_setr_pd(matrix[1].real(),
+            matrix[1].real(), matrix[2].real(), matrix[2].real());
+        const __m256d off_im = _mm256_setr_pd(matrix[1].imag(),
+            matrix[1].imag(), matrix[2].imag(), matrix[2].imag());
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (state_index = 0; state_index < dim; state_index += 2) {
+            double* p = ptr + 2 * state_index;
+            __m256d val = _mm256_loadu_pd(p);
+            __m256d val_pair = _mm256_permute2f128_pd(val, val, 0x01);
+            __m256d res = _mm256_add_pd(complex_mul_256(diag_re, diag_im, val),
+                complex_mul_256(off_re, off_im, val_pair));
+            _mm256_storeu_pd(p, res);
+        }
+    } else {
+        // two adjacent basis share the same target bit, so each register
+        // loads two strided pairs at once.
+        const __m256d m0_re = _mm256_set1_pd(matrix[0].real());
+        const __m256d m0_im = _mm256_set1_pd(matrix[0].imag());
+        const __m256d m1_re = _mm256_set1_pd(matrix[1].real());
+        const __m256d m1_im = _mm256_set1_pd(matrix[1].imag());
+        const __m256d m2_re = _mm256_set1_pd(matrix[2].real());
+        const __m256d m2_im = _mm256_set1_pd(matrix[2].imag());
+        const __m256d m3_re = _mm256_set1_pd(matrix[3].real());
+        const __m256d m3_im = _mm256_set1_pd(matrix[3].imag());
+        const ITYPE loop_dim = dim / 2;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (state_index = 0; state_index < loop_dim; state_index += 2) {
+            ITYPE basis_0 =
+                insert_zero_to_basis_index(state_index, target_qubit_index);
+            ITYPE basis_1 = basis_0 | mask;
+            double* p0 = ptr + 2 * basis_0;
+            double* p1 = ptr + 2 * basis_1;
+            __m256d val_0 = _mm256_loadu_pd(p0);
+            __m256d val_1 = _mm256_loadu_pd(p1);
+            __m256d res_0 = _mm256_add_pd(complex_mul_256(m0_re, m0_im, val_0),
+                complex_mul_256(m1_re, m1_im, val_1));
+            __m256d res_1 = _mm256_add_pd(complex_mul_256(m2_re, m2_im, val_0),
+                complex_mul_256(m3_re, m3_im, val_1));
+            _mm256_storeu_pd(p0, res_0);
+            _mm256_storeu_pd(p1, res_1);
+        }
+    }
+}
+#endif
+
+#ifdef __AVX512F__
+inline static __m512d complex_mul_512(
+    __m512d coef_re, __m512d coef_im, __m512d vec) {
+    __m512d vec_swap = _mm512_permute_pd(vec, 0b01010101);
+    return _mm512_fmaddsub_pd(coef_re, vec, _mm512_mul_pd(coef_im, vec_swap));
+}
+
+void single_qubit_dense_matrix_gate_parallel_avx512(
+    UINT target_qubit_index, const CTYPE matrix[4], CTYPE* state, ITYPE dim) {
+    double* ptr = reinterpret_cast<double*>(state);
+    const ITYPE mask = 1ULL << target_qubit_index;
+    ITYPE state_index;
+    if (target_qubit_index < 2) {
+        // one register holds four basis, i.e. two pairs for target 0 and one
+        // pair of pairs for target 1. Pick the partner by a lane shuffle.
+        double dr[4], di[4], or_[4], oi[4];
+        for (UINT j = 0; j < 4; ++j) {
+            bool bit = (j >> target_qubit_index) & 1;
+            CTYPE diag = bit ? matrix[3] : matrix[0];
+            CTYPE off = bit ? matrix[2] : matrix[1];
+            dr[j] = diag.real();
+            di[j] = diag.imag();
+            or_[j] = off.real();
+            oi[j] = off.imag();
+        }
+        const __m512d diag_re = _mm512_setr_pd(
+            dr[0], dr[0], dr[1], dr[1], dr[2], dr[2], dr[3], dr[3]);
+        const __m512d diag_im = _mm512_setr_pd(
+            di[0], di[0], di[1], di[1], di[2], di[2], di[3], di[3]);
+        const __m512d off_re = _mm512_setr_pd(
+            or_[0], or_[0], or_[1], or_[1], or_[2], or_[2], or_[3], or_[3]);
+        const __m512d off_im = _mm512_setr_pd(
+            oi[0], oi[0], oi[1], oi[1], oi[2], oi[2], oi[3], oi[3]);
+        const bool is_target_0 = (target_qubit_index == 0);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (state_index = 0; state_index < dim; state_index += 4) {
+            double* p = ptr + 2 * state_index;
+            __m512d val = _mm512_loadu_pd(p);
+            __m512d val_pair =
+                is_target_0
+                    ? _mm512_shuffle_f64x2(val, val, _MM_SHUFFLE(2, 3, 0, 1))
+                    : _mm512_shuffle_f64x2(val, val, _MM_SHUFFLE(1, 0, 3, 2));
+            __m512d res = _mm512_add_pd(complex_mul_512(diag_re, diag_im, val),
+                complex_mul_512(off_re, off_im, val_pair));
+            _mm512_storeu_pd(p, res);
+        }
+    } else {
+        const __m512d m0_re = _mm512_set1_pd(matrix[0].real());
+        const __m512d m0_im = _mm512_set1_pd(matrix[0].imag());
+        const __m512d m1_re = _mm512_set1_pd(matrix[1].real());
+        const __m512d m1_im = _mm512_set1_pd(matrix[1].imag());
+        const __m512d m2_re = _mm512_set1_pd(matrix[2].real());
+        const __m512d m2_im = _mm512_set1_pd(matrix[2].imag());
+        const __m512d m3_re = _mm512_set1_pd(matrix[3].real());
+        const __m512d m3_im = _mm512_set1_pd(matrix[3].imag());
+        const ITYPE loop_dim = dim / 2;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (state_index = 0; state_index < loop_dim; state_index += 4) {
+            ITYPE basis_0 =
+                insert_zero_to_basis_index(state_index, target_qubit_index);
+            ITYPE basis_1 = basis_0 | mask;
+            double* p0 = ptr + 2 * basis_0;
+            double* p1 = ptr + 2 * basis_1;
+            __m512d val_0 = _mm512_loadu_pd(p0);
+            __m512d val_1 = _mm512_loadu_pd(p1);
+            __m512d res_0 = _mm512_add_pd(complex_mul_512(m0_re, m0_im, val_0),
+                complex_mul_512(m1_re, m1_im, val_1));
+            __m512d res_1 = _mm512_add_pd(complex_mul_512(m2_re, m2_im, val_0),
+                complex_mul_512(m3_re, m3_im, val_1));
+            _mm512_storeu_pd(p0, res_0);
+            _mm512_storeu_pd(p1, res_1);
+        }
+    }
+}
+#endif
+
+template void single_qubit_dense_matrix_gate(
+    UINT target_qubit_index, const CTYPE matrix[4], CTYPE* state, ITYPE dim);
+template void single_qubit_dense_matrix_gate(UINT target_qubit_index,
+    const CTYPE matrix[4], CTYPE_F32* state, ITYPE dim);
+}  // namespace normal
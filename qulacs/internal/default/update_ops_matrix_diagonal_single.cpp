@@ -0,0 +1,90 @@
+#include <cmath>
+#include <vector>
+
+#ifdef _OPENMP
+#include "../general/omp_util.hpp"
+#endif
+
+#include "../general/number_util.hpp"
+#include "../general/type.hpp"
+#include "update_ops.hpp"
+
+namespace normal {
+template <typename FP>
+void single_qubit_diagonal_matrix_gate(UINT target_qubit_index,
+    const CTYPE diagonal_matrix[2], std::complex<FP>* state, ITYPE dim) {
+    const std::complex<FP> diag_0(diagonal_matrix[0]);
+    const std::complex<FP> diag_1(diagonal_matrix[1]);
+    const ITYPE loop_dim = dim;
+    // a single contiguous sweep; the factor only depends on the target bit
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 12);
+#pragma omp parallel for
+#endif
+    for (ITYPE state_index = 0; state_index < loop_dim; ++state_index) {
+        state[state_index] *=
+            ((state_index >> target_qubit_index) & 1) ? diag_1 : diag_0;
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template <typename FP>
+void RZ_gate(UINT target_qubit_index, double angle,
+    std::complex<FP>* state, ITYPE dim) {
+    const CTYPE diagonal_matrix[2] = {
+        CTYPE(cos(angle / 2), -sin(angle / 2)),
+        CTYPE(cos(angle / 2), sin(angle / 2))};
+    single_qubit_diagonal_matrix_gate(
+        target_qubit_index, diagonal_matrix, state, dim);
+}
+
+template <typename FP>
+void P0_gate(UINT target_qubit_index, std::complex<FP>* state, ITYPE dim) {
+    const ITYPE loop_dim = dim / 2;
+    const ITYPE mask = 1ULL << target_qubit_index;
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE state_index = 0; state_index < loop_dim; ++state_index) {
+        ITYPE basis_1 =
+            insert_zero_to_basis_index(state_index, target_qubit_index) | mask;
+        state[basis_1] = 0;
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template <typename FP>
+void P1_gate(UINT target_qubit_index, std::complex<FP>* state, ITYPE dim) {
+    const ITYPE loop_dim = dim / 2;
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE state_index = 0; state_index < loop_dim; ++state_index) {
+        ITYPE basis_0 =
+            insert_zero_to_basis_index(state_index, target_qubit_index);
+        state[basis_0] = 0;
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template void single_qubit_diagonal_matrix_gate(UINT target_qubit_index,
+    const CTYPE diagonal_matrix[2], CTYPE* state, ITYPE dim);
+template void single_qubit_diagonal_matrix_gate(UINT target_qubit_index,
+    const CTYPE diagonal_matrix[2], CTYPE_F32* state, ITYPE dim);
+template void RZ_gate(
+    UINT target_qubit_index, double angle, CTYPE* state, ITYPE dim);
+template void RZ_gate(
+    UINT target_qubit_index, double angle, CTYPE_F32* state, ITYPE dim);
+template void P0_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+template void P0_gate(UINT target_qubit_index, CTYPE_F32* state, ITYPE dim);
+template void P1_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+template void P1_gate(UINT target_qubit_index, CTYPE_F32* state, ITYPE dim);
+}  // namespace normal
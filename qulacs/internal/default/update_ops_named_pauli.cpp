@@ -0,0 +1,78 @@
+#include <vector>
+
+#ifdef _OPENMP
+#include "../general/omp_util.hpp"
+#endif
+
+#include "../general/number_util.hpp"
+#include "../general/type.hpp"
+#include "update_ops.hpp"
+
+namespace normal {
+template <typename FP>
+void X_gate(UINT target_qubit_index, std::complex<FP>* state, ITYPE dim) {
+    const ITYPE loop_dim = dim / 2;
+    const ITYPE mask = 1ULL << target_qubit_index;
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE state_index = 0; state_index < loop_dim; ++state_index) {
+        ITYPE basis_0 =
+            insert_zero_to_basis_index(state_index, target_qubit_index);
+        ITYPE basis_1 = basis_0 | mask;
+        std::swap(state[basis_0], state[basis_1]);
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template <typename FP>
+void Y_gate(UINT target_qubit_index, std::complex<FP>* state, ITYPE dim) {
+    const ITYPE loop_dim = dim / 2;
+    const ITYPE mask = 1ULL << target_qubit_index;
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE state_index = 0; state_index < loop_dim; ++state_index) {
+        ITYPE basis_0 =
+            insert_zero_to_basis_index(state_index, target_qubit_index);
+        ITYPE basis_1 = basis_0 | mask;
+        std::complex<FP> cval_0 = state[basis_0];
+        std::complex<FP> cval_1 = state[basis_1];
+        // new_0 = -i * cval_1, new_1 = i * cval_0
+        state[basis_0] = std::complex<FP>(cval_1.imag(), -cval_1.real());
+        state[basis_1] = std::complex<FP>(-cval_0.imag(), cval_0.real());
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template <typename FP>
+void Z_gate(UINT target_qubit_index, std::complex<FP>* state, ITYPE dim) {
+    const ITYPE loop_dim = dim / 2;
+    const ITYPE mask = 1ULL << target_qubit_index;
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE state_index = 0; state_index < loop_dim; ++state_index) {
+        ITYPE basis_1 =
+            insert_zero_to_basis_index(state_index, target_qubit_index) | mask;
+        state[basis_1] = -state[basis_1];
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template void X_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+template void X_gate(UINT target_qubit_index, CTYPE_F32* state, ITYPE dim);
+template void Y_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+template void Y_gate(UINT target_qubit_index, CTYPE_F32* state, ITYPE dim);
+template void Z_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+template void Z_gate(UINT target_qubit_index, CTYPE_F32* state, ITYPE dim);
+}  // namespace normal
@@ -0,0 +1,95 @@
+#include <vector>
+
+#ifdef _OPENMP
+#include "../general/omp_util.hpp"
+#endif
+
+#include "../general/constant.hpp"
+#include "../general/number_util.hpp"
+#include "../general/type.hpp"
+#include "update_ops.hpp"
+
+namespace normal {
+template <typename FP>
+void S_gate(UINT target_qubit_index, std::complex<FP>* state, ITYPE dim) {
+    const ITYPE loop_dim = dim / 2;
+    const ITYPE mask = 1ULL << target_qubit_index;
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE state_index = 0; state_index < loop_dim; ++state_index) {
+        ITYPE basis_1 =
+            insert_zero_to_basis_index(state_index, target_qubit_index) | mask;
+        std::complex<FP> cval = state[basis_1];
+        state[basis_1] = std::complex<FP>(-cval.imag(), cval.real());
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template <typename FP>
+void Sdag_gate(UINT target_qubit_index, std::complex<FP>* state, ITYPE dim) {
+    const ITYPE loop_dim = dim / 2;
+    const ITYPE mask = 1ULL << target_qubit_index;
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE state_index = 0; state_index < loop_dim; ++state_index) {
+        ITYPE basis_1 =
+            insert_zero_to_basis_index(state_index, target_qubit_index) | mask;
+        std::complex<FP> cval = state[basis_1];
+        state[basis_1] = std::complex<FP>(cval.imag(), -cval.real());
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template <typename FP>
+void T_gate(UINT target_qubit_index, std::complex<FP>* state, ITYPE dim) {
+    single_qubit_phase_gate(
+        target_qubit_index, CTYPE(1. / SQRT2, 1. / SQRT2), state, dim);
+}
+
+template <typename FP>
+void Tdag_gate(UINT target_qubit_index, std::complex<FP>* state, ITYPE dim) {
+    single_qubit_phase_gate(
+        target_qubit_index, CTYPE(1. / SQRT2, -1. / SQRT2), state, dim);
+}
+
+template <typename FP>
+void single_qubit_phase_gate(UINT target_qubit_index, CTYPE phase,
+    std::complex<FP>* state, ITYPE dim) {
+    const ITYPE loop_dim = dim / 2;
+    const ITYPE mask = 1ULL << target_qubit_index;
+    const std::complex<FP> phase_fp(phase);
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE state_index = 0; state_index < loop_dim; ++state_index) {
+        ITYPE basis_1 =
+            insert_zero_to_basis_index(state_index, target_qubit_index) | mask;
+        state[basis_1] *= phase_fp;
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template void S_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+template void S_gate(UINT target_qubit_index, CTYPE_F32* state, ITYPE dim);
+template void Sdag_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+template void Sdag_gate(UINT target_qubit_index, CTYPE_F32* state, ITYPE dim);
+template void T_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+template void T_gate(UINT target_qubit_index, CTYPE_F32* state, ITYPE dim);
+template void Tdag_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+template void Tdag_gate(UINT target_qubit_index, CTYPE_F32* state, ITYPE dim);
+template void single_qubit_phase_gate(
+    UINT target_qubit_index, CTYPE phase, CTYPE* state, ITYPE dim);
+template void single_qubit_phase_gate(
+    UINT target_qubit_index, CTYPE phase, CTYPE_F32* state, ITYPE dim);
+}  // namespace normal
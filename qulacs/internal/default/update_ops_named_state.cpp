@@ -1,18 +1,53 @@
+#include <cmath>
+
+#ifdef _OPENMP
+#include "../general/omp_util.hpp"
+#endif
+
 #include "update_ops.hpp"
 
 namespace normal {
-void normalize(std::vector<CTYPE>& state, double norm) {
-    const double normalize_factor = 1.0 / sqrt(norm);
+template <typename FP>
+void normalize(std::complex<FP>* state, ITYPE dim, double norm) {
+    const FP normalize_factor = 1.0 / sqrt(norm);
+    const ITYPE loop_dim = dim;
 #ifdef _OPENMP
     OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
 #pragma omp parallel for
 #endif
-    for (ITYPE state_index = 0, loop_dim = state.size(); state_index < loop_dim;
-         ++state_index) {
+    for (ITYPE state_index = 0; state_index < loop_dim; ++state_index) {
         state[state_index] *= normalize_factor;
     }
 #ifdef _OPENMP
     OMPutil::get_inst().reset_qulacs_num_threads();
 #endif
 }
-}  // namespace normal
\ No newline at end of file
+
+template <typename FP>
+void project_and_normalize(ITYPE mask, ITYPE value, double norm,
+    std::complex<FP>* state, ITYPE dim) {
+    const FP normalize_factor = 1.0 / sqrt(norm);
+    const ITYPE loop_dim = dim;
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE state_index = 0; state_index < loop_dim; ++state_index) {
+        if ((state_index & mask) == value) {
+            state[state_index] *= normalize_factor;
+        } else {
+            state[state_index] = 0;
+        }
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template void normalize(CTYPE* state, ITYPE dim, double norm);
+template void normalize(CTYPE_F32* state, ITYPE dim, double norm);
+template void project_and_normalize(ITYPE mask, ITYPE value, double norm,
+    CTYPE* state, ITYPE dim);
+template void project_and_normalize(ITYPE mask, ITYPE value, double norm,
+    CTYPE_F32* state, ITYPE dim);
+}  // namespace normal
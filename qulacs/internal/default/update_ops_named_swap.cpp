@@ -0,0 +1,45 @@
+#include <algorithm>
+#include <vector>
+
+#ifdef _OPENMP
+#include "../general/omp_util.hpp"
+#endif
+
+#include "../general/number_util.hpp"
+#include "../general/type.hpp"
+#include "update_ops.hpp"
+
+namespace normal {
+template <typename FP>
+void SWAP_gate(UINT target_qubit_index_0, UINT target_qubit_index_1,
+    std::complex<FP>* state, ITYPE dim) {
+    if (target_qubit_index_0 == target_qubit_index_1) return;
+    const ITYPE loop_dim = dim / 4;
+    const ITYPE mask_0 = 1ULL << target_qubit_index_0;
+    const ITYPE mask_1 = 1ULL << target_qubit_index_1;
+    const UINT min_qubit_index =
+        std::min(target_qubit_index_0, target_qubit_index_1);
+    const UINT max_qubit_index =
+        std::max(target_qubit_index_0, target_qubit_index_1);
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE state_index = 0; state_index < loop_dim; ++state_index) {
+        // consecutive state_index below min_qubit_index are consecutive
+        // in memory, so both halves are streamed
+        ITYPE basis_00 =
+            insert_zero_to_basis_index(state_index, min_qubit_index);
+        basis_00 = insert_zero_to_basis_index(basis_00, max_qubit_index);
+        std::swap(state[basis_00 | mask_0], state[basis_00 | mask_1]);
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+template void SWAP_gate(UINT target_qubit_index_0, UINT target_qubit_index_1,
+    CTYPE* state, ITYPE dim);
+template void SWAP_gate(UINT target_qubit_index_0, UINT target_qubit_index_1,
+    CTYPE_F32* state, ITYPE dim);
+}  // namespace normal
@@ -0,0 +1,90 @@
+/**
+ * @file aligned_allocator.hpp
+ * @brief Allocator for state vectors
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "type.hpp"
+
+//! alignment of every allocation. one cache line, and one AVX-512 register
+constexpr std::size_t ALIGNED_ALLOCATOR_ALIGNMENT = 64;
+//! alignment of allocations not smaller than a huge page
+constexpr std::size_t ALIGNED_ALLOCATOR_HUGE_PAGE_SIZE = 2ULL << 20;
+
+/**
+ * std-compatible allocator for state vectors.
+ *
+ * Memory is aligned to 64 bytes, or to 2 MiB when at least one huge page is
+ * requested so that transparent huge pages can back it (MADV_HUGEPAGE on
+ * Linux).
+ *
+ * Value-initialized elements are left unwritten, so no page is touched
+ * here. The initializers of StateVector write the state first with
+ * the same OpenMP static schedule as the update kernels, so on NUMA systems
+ * each thread's part of the state is placed on the thread's own node.
+ */
+template <typename T>
+class AlignedAllocator {
+public:
+    using value_type = T;
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t count) {
+        const std::size_t byte_count = count * sizeof(T);
+        const std::size_t alignment = get_alignment(byte_count);
+        void* ptr = ::operator new(byte_count, std::align_val_t(alignment));
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (alignment == ALIGNED_ALLOCATOR_HUGE_PAGE_SIZE) {
+            // only a hint. ignore failure on kernels without THP
+            madvise(ptr, byte_count, MADV_HUGEPAGE);
+        }
+#endif
+        return static_cast<T*>(ptr);
+    }
+
+    /**
+     * Leave the element uninitialized. <code>T</code> must be trivially
+     * destructible and be written before it is read.
+     */
+    template <typename U>
+    void construct(U*) noexcept {}
+
+    template <typename U, typename... Args>
+    void construct(U* ptr, Args&&... args) {
+        ::new (static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+    }
+
+    void deallocate(T* ptr, std::size_t count) noexcept {
+        ::operator delete(
+            ptr, std::align_val_t(get_alignment(count * sizeof(T))));
+    }
+
+private:
+    static std::size_t get_alignment(std::size_t byte_count) {
+        return byte_count >= ALIGNED_ALLOCATOR_HUGE_PAGE_SIZE
+                   ? ALIGNED_ALLOCATOR_HUGE_PAGE_SIZE
+                   : ALIGNED_ALLOCATOR_ALIGNMENT;
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const AlignedAllocator<T>&, const AlignedAllocator<U>&) {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const AlignedAllocator<T>&, const AlignedAllocator<U>&) {
+    return false;
+}
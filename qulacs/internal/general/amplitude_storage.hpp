@@ -0,0 +1,95 @@
+/**
+ * @file amplitude_storage.hpp
+ * @brief Storage of state vector amplitudes
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "type.hpp"
+
+/**
+ * Non-owning read-only view of amplitudes, in the manner of
+ * std::span<const T> which is not available in C++17.
+ */
+template <typename T>
+class AmplitudeView {
+private:
+    const T* _ptr;
+    ITYPE _size;
+
+public:
+    AmplitudeView(const T* ptr, ITYPE size) : _ptr(ptr), _size(size) {}
+
+    const T* data() const { return _ptr; }
+    ITYPE size() const { return _size; }
+    const T* begin() const { return _ptr; }
+    const T* end() const { return _ptr + _size; }
+    const T& operator[](ITYPE index) const { return _ptr[index]; }
+};
+
+/**
+ * Contiguous amplitudes of a state vector.
+ *
+ * The amplitudes live in one of three places: a buffer allocated by
+ * AlignedAllocator (the default), a std::vector adopted by move, or an
+ * external buffer which is only referenced and must outlive the storage.
+ * Kernels only see <code>data()</code>, so all three are handled alike.
+ */
+template <typename T>
+class AmplitudeStorage {
+private:
+    std::vector<T, AlignedAllocator<T>> _aligned;
+    std::vector<T> _adopted;
+    T* _ptr;
+    ITYPE _size;
+    bool _is_owner;
+
+public:
+    /**
+     * Allocate <code>size</code> amplitudes without initializing them.
+     */
+    explicit AmplitudeStorage(ITYPE size)
+        : _aligned(size), _ptr(_aligned.data()), _size(size), _is_owner(true) {}
+
+    AmplitudeStorage(const AmplitudeStorage&) = delete;
+    AmplitudeStorage& operator=(const AmplitudeStorage&) = delete;
+    AmplitudeStorage(AmplitudeStorage&&) = default;
+    AmplitudeStorage& operator=(AmplitudeStorage&&) = default;
+
+    T* data() { return _ptr; }
+    const T* data() const { return _ptr; }
+    ITYPE size() const { return _size; }
+    T& operator[](ITYPE index) { return _ptr[index]; }
+    const T& operator[](ITYPE index) const { return _ptr[index]; }
+
+    /**
+     * Take over the buffer of <code>vec</code> without copying.
+     */
+    void adopt(std::vector<T>&& vec) {
+        _adopted = std::move(vec);
+        _ptr = _adopted.data();
+        _size = _adopted.size();
+        _is_owner = true;
+        std::vector<T, AlignedAllocator<T>>().swap(_aligned);
+    }
+
+    /**
+     * Refer to the external buffer <code>ptr</code> without copying. The
+     * caller keeps the ownership.
+     */
+    void wrap(T* ptr, ITYPE size) {
+        _ptr = ptr;
+        _size = size;
+        _is_owner = false;
+        std::vector<T, AlignedAllocator<T>>().swap(_aligned);
+        std::vector<T>().swap(_adopted);
+    }
+
+    /**
+     * Whether the amplitudes are owned by this storage.
+     */
+    bool is_owner() const { return _is_owner; }
+};
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <sstream>
 #include <stdexcept>
+#include <vector>
 
 #include "type.hpp"
 
@@ -23,4 +26,15 @@ void check_equal(const std::string& arg_name, T value, T constraint) {
            << constraint << ".";
         throw std::out_of_range(ss.str());
     }
+}
+
+template <typename T>
+void check_no_duplicate(const std::string& arg_name, std::vector<T> values) {
+    std::sort(values.begin(), values.end());
+    auto ite = std::adjacent_find(values.begin(), values.end());
+    if (ite != values.end()) {
+        std::stringstream ss;
+        ss << arg_name << " has duplicated value: " << *ite << ".";
+        throw std::invalid_argument(ss.str());
+    }
 }
\ No newline at end of file
@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
 #include "type.hpp"
 
 /**
@@ -16,3 +19,41 @@ inline static ITYPE insert_zero_to_basis_index(
     ITYPE temp_basis = (basis_index >> qubit_index) << (qubit_index + 1);
     return temp_basis + basis_index % (1ULL << qubit_index);
 }
+
+/**
+ * Count the number of set bits.
+ */
+inline static UINT count_population(ITYPE value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(value);
+#else
+    UINT count = 0;
+    for (; value != 0; value &= value - 1) ++count;
+    return count;
+#endif
+}
+
+/**
+ * Create the list of lower bit masks used by insert_zeros_to_basis_index.
+ * Each mask is (1ULL << qubit_index) - 1 in ascending order of qubit_index.
+ */
+inline static std::vector<ITYPE> create_insert_zero_mask_list(
+    std::vector<UINT> qubit_index_list) {
+    std::sort(qubit_index_list.begin(), qubit_index_list.end());
+    std::vector<ITYPE> mask_list(qubit_index_list.size());
+    for (UINT i = 0; i < qubit_index_list.size(); ++i) {
+        mask_list[i] = (1ULL << qubit_index_list[i]) - 1;
+    }
+    return mask_list;
+}
+
+/**
+ * Insert 0 to every bit position given by create_insert_zero_mask_list.
+ */
+inline static ITYPE insert_zeros_to_basis_index(
+    ITYPE basis_index, const std::vector<ITYPE>& insert_mask_list) {
+    for (ITYPE mask : insert_mask_list) {
+        basis_index = (basis_index & mask) + ((basis_index & ~mask) << 1);
+    }
+    return basis_index;
+}
@@ -3,7 +3,10 @@
 void OMPutil::set_qulacs_num_threads(ITYPE dim, UINT para_threshold) {
     UINT threshold = para_threshold;
     if (qulacs_force_threshold > 0) threshold = qulacs_force_threshold;
-    if (dim < (((ITYPE)1) << threshold)) {
+    // a kernel called inside an active parallel region (e.g. per block of
+    // Circuit::update_quantum_state_blocked) stays on its thread, whatever
+    // OMP_MAX_ACTIVE_LEVELS allows
+    if (omp_in_parallel() || dim < (((ITYPE)1) << threshold)) {
         omp_set_num_threads(1);
     } else {
         omp_set_num_threads(qulacs_num_thread_max);
@@ -12,4 +15,9 @@ void OMPutil::set_qulacs_num_threads(ITYPE dim, UINT para_threshold) {
 
 void OMPutil::reset_qulacs_num_threads() {
     omp_set_num_threads(qulacs_num_default_thread_max);
-}
\ No newline at end of file
+}
+
+void OMPutil::set_qulacs_num_thread_max(UINT num_thread_max) {
+    if (0 < num_thread_max && num_thread_max <= MAX_NUM_THREADS)
+        qulacs_num_thread_max = num_thread_max;
+}
@@ -41,4 +41,7 @@ public:
     }
     void set_qulacs_num_threads(ITYPE dim, UINT para_threshold);
     void reset_qulacs_num_threads();
+    // overrides QULACS_NUM_THREADS, e.g. to sweep thread counts in benchmarks
+    void set_qulacs_num_thread_max(UINT num_thread_max);
+    UINT get_qulacs_num_thread_max() const { return qulacs_num_thread_max; }
 };
\ No newline at end of file
@@ -0,0 +1,255 @@
+#include "random.hpp"
+
+#ifdef _USE_SIMD
+#include <immintrin.h>
+#endif
+
+// Box-Muller transform with branch-free polynomial log and sincos, so that
+// the scalar and SIMD code share one algorithm.
+
+static constexpr double LN2 = 0.6931471805599453;
+static constexpr double SQRT2_VALUE = 1.4142135623730951;
+static constexpr double TWO_PI = 6.283185307179586;
+
+// 2 / (2k + 1) for log(m) = 2 atanh(s) = sum 2 s^(2k+1) / (2k + 1)
+static constexpr double LOG_COEF[9] = {2., 2. / 3, 2. / 5, 2. / 7, 2. / 9,
+    2. / 11, 2. / 13, 2. / 15, 2. / 17};
+// (-1)^k / (2k + 1)! and (-1)^k / (2k)!
+static constexpr double SIN_COEF[8] = {1., -1. / 6, 1. / 120, -1. / 5040,
+    1. / 362880, -1. / 39916800, 1. / 6227020800, -1. / 1307674368000};
+static constexpr double COS_COEF[9] = {1., -1. / 2, 1. / 24, -1. / 720,
+    1. / 40320, -1. / 3628800, 1. / 479001600, -1. / 87178291200,
+    1. / 20922789888000};
+
+/**
+ * log(u) for u in (0, 1]. Relative error is about 1e-16.
+ */
+static inline double log_unit(double u) {
+    uint64_t bits;
+    std::memcpy(&bits, &u, sizeof(double));
+    double exponent = (double)(int64_t)(bits >> 52) - 1023.;
+    const uint64_t mantissa_bits =
+        (bits & 0x000FFFFFFFFFFFFFULL) | 0x3FF0000000000000ULL;
+    double mantissa;
+    std::memcpy(&mantissa, &mantissa_bits, sizeof(double));
+    // move the mantissa to [1/sqrt(2), sqrt(2)) where the series converges
+    // fast
+    const bool is_large = mantissa > SQRT2_VALUE;
+    mantissa = is_large ? mantissa * 0.5 : mantissa;
+    exponent = is_large ? exponent + 1. : exponent;
+    const double s = (mantissa - 1.) / (mantissa + 1.);
+    const double z = s * s;
+    double poly = LOG_COEF[8];
+    for (int k = 7; k >= 0; --k) poly = poly * z + LOG_COEF[k];
+    return exponent * LN2 + s * poly;
+}
+
+/**
+ * sin and cos of 2 pi u for u in (0, 1].
+ */
+static inline void sincos_2pi(double u, double& sin_value, double& cos_value) {
+    const double quadrant = std::nearbyint(4. * u);
+    const double x = TWO_PI * (u - 0.25 * quadrant);
+    const double z = x * x;
+    double sin_poly = SIN_COEF[7], cos_poly = COS_COEF[8];
+    for (int k = 6; k >= 0; --k) sin_poly = sin_poly * z + SIN_COEF[k];
+    for (int k = 7; k >= 0; --k) cos_poly = cos_poly * z + COS_COEF[k];
+    const double s = x * sin_poly, c = cos_poly;
+    // rotate by quadrant * pi / 2. quadrant 4 is the same as 0
+    const bool is_odd = (quadrant == 1. || quadrant == 3.);
+    const bool is_sin_negative = (quadrant == 2. || quadrant == 3.);
+    const bool is_cos_negative = (quadrant == 1. || quadrant == 2.);
+    const double sin_abs = is_odd ? c : s;
+    const double cos_abs = is_odd ? s : c;
+    sin_value = is_sin_negative ? -sin_abs : sin_abs;
+    cos_value = is_cos_negative ? -cos_abs : cos_abs;
+}
+
+static inline void normal_pair_from_block(
+    const PhiloxEngine::Block& block, double& normal_0, double& normal_1) {
+    const double u0 = PhiloxEngine::to_uniform(
+        PhiloxEngine::to_uint64(block[0], block[1]));
+    const double u1 = PhiloxEngine::to_uniform(
+        PhiloxEngine::to_uint64(block[2], block[3]));
+    const double radius = std::sqrt(-2. * log_unit(u0));
+    double sin_value, cos_value;
+    sincos_2pi(u1, sin_value, cos_value);
+    normal_0 = radius * cos_value;
+    normal_1 = radius * sin_value;
+}
+
+#ifdef _USE_SIMD
+/**
+ * Philox4x32-10 on four consecutive blocks. Each 64-bit lane holds one
+ * 32-bit word of one block. Returns the two 64-bit outputs of each block.
+ */
+static inline void generate_block_simd(uint64_t seed, uint64_t stream,
+    uint64_t block_index, __m256i& value_0, __m256i& value_1) {
+    const __m256i mask_32 = _mm256_set1_epi64x(0xFFFFFFFFLL);
+    const __m256i multiplier_0 = _mm256_set1_epi64x(0xD2511F53LL);
+    const __m256i multiplier_1 = _mm256_set1_epi64x(0xCD9E8D57LL);
+    const __m256i index = _mm256_add_epi64(
+        _mm256_set1_epi64x(block_index), _mm256_setr_epi64x(0, 1, 2, 3));
+    __m256i c0 = _mm256_and_si256(index, mask_32);
+    __m256i c1 = _mm256_srli_epi64(index, 32);
+    __m256i c2 = _mm256_set1_epi64x(stream & 0xFFFFFFFFULL);
+    __m256i c3 = _mm256_set1_epi64x(stream >> 32);
+    uint32_t k0 = (uint32_t)seed, k1 = seed >> 32;
+    for (int round = 0; round < 10; ++round) {
+        const __m256i p0 = _mm256_mul_epu32(c0, multiplier_0);
+        const __m256i p1 = _mm256_mul_epu32(c2, multiplier_1);
+        const __m256i n0 = _mm256_xor_si256(
+            _mm256_xor_si256(_mm256_srli_epi64(p1, 32), c1),
+            _mm256_set1_epi64x(k0));
+        const __m256i n2 = _mm256_xor_si256(
+            _mm256_xor_si256(_mm256_srli_epi64(p0, 32), c3),
+            _mm256_set1_epi64x(k1));
+        c0 = n0;
+        c1 = _mm256_and_si256(p1, mask_32);
+        c2 = n2;
+        c3 = _mm256_and_si256(p0, mask_32);
+        k0 += 0x9E3779B9;
+        k1 += 0xBB67AE85;
+    }
+    value_0 = _mm256_or_si256(_mm256_slli_epi64(c1, 32), c0);
+    value_1 = _mm256_or_si256(_mm256_slli_epi64(c3, 32), c2);
+}
+
+static inline __m256d to_uniform_simd(__m256i value) {
+    const __m256i bits =
+        _mm256_or_si256(_mm256_srli_epi64(value, 12),
+            _mm256_set1_epi64x(0x3FF0000000000000LL));
+    return _mm256_sub_pd(_mm256_set1_pd(2.), _mm256_castsi256_pd(bits));
+}
+
+static inline __m256d log_unit_simd(__m256d u) {
+    const __m256i bits = _mm256_castpd_si256(u);
+    // exponent as double by the 2^52 magic number
+    const __m256i exponent_bits = _mm256_or_si256(_mm256_srli_epi64(bits, 52),
+        _mm256_set1_epi64x(0x4330000000000000LL));
+    __m256d exponent =
+        _mm256_sub_pd(_mm256_castsi256_pd(exponent_bits),
+            _mm256_set1_pd(4503599627370496. + 1023.));
+    __m256d mantissa = _mm256_castsi256_pd(_mm256_or_si256(
+        _mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL)),
+        _mm256_set1_epi64x(0x3FF0000000000000LL)));
+    const __m256d is_large =
+        _mm256_cmp_pd(mantissa, _mm256_set1_pd(SQRT2_VALUE), _CMP_GT_OQ);
+    mantissa = _mm256_blendv_pd(
+        mantissa, _mm256_mul_pd(mantissa, _mm256_set1_pd(0.5)), is_large);
+    exponent = _mm256_blendv_pd(
+        exponent, _mm256_add_pd(exponent, _mm256_set1_pd(1.)), is_large);
+    const __m256d one = _mm256_set1_pd(1.);
+    const __m256d s = _mm256_div_pd(
+        _mm256_sub_pd(mantissa, one), _mm256_add_pd(mantissa, one));
+    const __m256d z = _mm256_mul_pd(s, s);
+    __m256d poly = _mm256_set1_pd(LOG_COEF[8]);
+    for (int k = 7; k >= 0; --k) {
+        poly = _mm256_fmadd_pd(poly, z, _mm256_set1_pd(LOG_COEF[k]));
+    }
+    return _mm256_fmadd_pd(
+        exponent, _mm256_set1_pd(LN2), _mm256_mul_pd(s, poly));
+}
+
+static inline void sincos_2pi_simd(
+    __m256d u, __m256d& sin_value, __m256d& cos_value) {
+    const __m256d quadrant = _mm256_round_pd(
+        _mm256_mul_pd(_mm256_set1_pd(4.), u),
+        _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    const __m256d x = _mm256_mul_pd(_mm256_set1_pd(TWO_PI),
+        _mm256_fnmadd_pd(_mm256_set1_pd(0.25), quadrant, u));
+    const __m256d z = _mm256_mul_pd(x, x);
+    __m256d sin_poly = _mm256_set1_pd(SIN_COEF[7]);
+    __m256d cos_poly = _mm256_set1_pd(COS_COEF[8]);
+    for (int k = 6; k >= 0; --k) {
+        sin_poly = _mm256_fmadd_pd(sin_poly, z, _mm256_set1_pd(SIN_COEF[k]));
+    }
+    for (int k = 7; k >= 0; --k) {
+        cos_poly = _mm256_fmadd_pd(cos_poly, z, _mm256_set1_pd(COS_COEF[k]));
+    }
+    const __m256d s = _mm256_mul_pd(x, sin_poly), c = cos_poly;
+    const __m256d q1 = _mm256_cmp_pd(quadrant, _mm256_set1_pd(1.), _CMP_EQ_OQ);
+    const __m256d q2 = _mm256_cmp_pd(quadrant, _mm256_set1_pd(2.), _CMP_EQ_OQ);
+    const __m256d q3 = _mm256_cmp_pd(quadrant, _mm256_set1_pd(3.), _CMP_EQ_OQ);
+    const __m256d is_odd = _mm256_or_pd(q1, q3);
+    const __m256d sign_bit = _mm256_set1_pd(-0.);
+    const __m256d sin_abs = _mm256_blendv_pd(s, c, is_odd);
+    const __m256d cos_abs = _mm256_blendv_pd(c, s, is_odd);
+    sin_value = _mm256_xor_pd(
+        sin_abs, _mm256_and_pd(_mm256_or_pd(q2, q3), sign_bit));
+    cos_value = _mm256_xor_pd(
+        cos_abs, _mm256_and_pd(_mm256_or_pd(q1, q2), sign_bit));
+}
+#endif
+
+void PhiloxEngine::fill_normal(double* out, ITYPE count, double scale) {
+    _offset += _offset % 2;
+    const uint64_t first_block_index = _offset / 2;
+    const ITYPE pair_count = count / 2;
+    ITYPE pair_index = 0;
+#ifdef _USE_SIMD
+    const __m256d scale_vec = _mm256_set1_pd(scale);
+    for (; pair_index + 4 <= pair_count; pair_index += 4) {
+        __m256i value_0, value_1;
+        generate_block_simd(_seed, _stream, first_block_index + pair_index,
+            value_0, value_1);
+        const __m256d radius = _mm256_mul_pd(scale_vec,
+            _mm256_sqrt_pd(_mm256_mul_pd(_mm256_set1_pd(-2.),
+                log_unit_simd(to_uniform_simd(value_0)))));
+        __m256d sin_value, cos_value;
+        sincos_2pi_simd(to_uniform_simd(value_1), sin_value, cos_value);
+        const __m256d normal_0 = _mm256_mul_pd(radius, cos_value);
+        const __m256d normal_1 = _mm256_mul_pd(radius, sin_value);
+        // interleave to (n0, n1) pairs of blocks 0..3
+        const __m256d low = _mm256_unpacklo_pd(normal_0, normal_1);
+        const __m256d high = _mm256_unpackhi_pd(normal_0, normal_1);
+        double* p = out + 2 * pair_index;
+        _mm256_storeu_pd(p, _mm256_permute2f128_pd(low, high, 0x20));
+        _mm256_storeu_pd(p + 4, _mm256_permute2f128_pd(low, high, 0x31));
+    }
+#endif
+    for (; pair_index < pair_count; ++pair_index) {
+        double normal_0, normal_1;
+        normal_pair_from_block(
+            generate_block(_seed, _stream, first_block_index + pair_index),
+            normal_0, normal_1);
+        out[2 * pair_index] = scale * normal_0;
+        out[2 * pair_index + 1] = scale * normal_1;
+    }
+    if (count % 2 == 1) {
+        double normal_0, normal_1;
+        normal_pair_from_block(
+            generate_block(_seed, _stream, first_block_index + pair_count),
+            normal_0, normal_1);
+        out[count - 1] = scale * normal_0;
+    }
+    _offset += count + count % 2;
+}
+
+double PhiloxEngine::sum_squared_normal(ITYPE count) {
+    _offset += _offset % 2;
+    const uint64_t first_block_index = _offset / 2;
+    const ITYPE pair_count = count / 2;
+    ITYPE pair_index = 0;
+    double sum = 0.;
+#ifdef _USE_SIMD
+    __m256d sum_vec = _mm256_setzero_pd();
+    for (; pair_index + 4 <= pair_count; pair_index += 4) {
+        __m256i value_0, value_1;
+        generate_block_simd(_seed, _stream, first_block_index + pair_index,
+            value_0, value_1);
+        sum_vec = _mm256_add_pd(
+            sum_vec, log_unit_simd(to_uniform_simd(value_0)));
+    }
+    double sum_list[4];
+    _mm256_storeu_pd(sum_list, sum_vec);
+    sum = (sum_list[0] + sum_list[1]) + (sum_list[2] + sum_list[3]);
+#endif
+    for (; pair_index < pair_count; ++pair_index) {
+        const Block block =
+            generate_block(_seed, _stream, first_block_index + pair_index);
+        sum += log_unit(to_uniform(to_uint64(block[0], block[1])));
+    }
+    _offset += count;
+    return -2. * sum;
+}
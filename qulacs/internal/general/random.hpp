@@ -6,37 +6,178 @@
 #pragma once
 
 #include <array>
-#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <random>
 
 #include "type.hpp"
 
-class XorShiftEngine {
+/**
+ * Counter-based generator Philox4x32-10.
+ *
+ * The i-th 64-bit output of stream <code>s</code> is a pure function of
+ * (seed, s, i), so any thread can jump to any stream or offset in O(1).
+ * Splitting work by offsets instead of by threads makes the random numbers
+ * independent of the number of threads.
+ */
+class PhiloxEngine {
+public:
+    using result_type = uint64_t;
+    //! one block, i.e. one evaluation of the bijection
+    using Block = std::array<uint32_t, 4>;
+
 private:
-    std::array<ITYPE, 4> state;
+    static constexpr uint32_t MULTIPLIER_0 = 0xD2511F53;
+    static constexpr uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+    static constexpr uint32_t WEYL_0 = 0x9E3779B9;
+    static constexpr uint32_t WEYL_1 = 0xBB67AE85;
+
+    uint64_t _seed;
+    uint64_t _stream;
+    uint64_t _offset;
+    uint64_t _buffer_index;
+    Block _buffer{};
 
 public:
-    void seed(UINT seed_) {
-        srand(seed_);
-        state[0] = rand();
-        state[1] = rand();
-        state[2] = rand();
-        state[3] = rand();
+    /**
+     * Compute the <code>block_index</code>-th block of stream
+     * <code>stream</code>. Each block holds two 64-bit outputs.
+     */
+    static inline Block generate_block(
+        uint64_t seed, uint64_t stream, uint64_t block_index) {
+        uint32_t c0 = (uint32_t)block_index, c1 = block_index >> 32,
+                 c2 = (uint32_t)stream, c3 = stream >> 32;
+        uint32_t k0 = (uint32_t)seed, k1 = seed >> 32;
+        for (int round = 0; round < 10; ++round) {
+            const uint64_t p0 = (uint64_t)MULTIPLIER_0 * c0;
+            const uint64_t p1 = (uint64_t)MULTIPLIER_1 * c2;
+            const uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+            const uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+            c0 = n0;
+            c1 = (uint32_t)p1;
+            c2 = n2;
+            c3 = (uint32_t)p0;
+            k0 += WEYL_0;
+            k1 += WEYL_1;
+        }
+        return {c0, c1, c2, c3};
     }
 
-    ITYPE operator()() {
-        ITYPE t;
-        t = (state[0] ^ (state[0] << 11));
-        state[0] = state[1];
-        state[1] = state[2];
-        state[2] = state[3];
-        return (state[3] = (state[3] ^ (state[3] >> 19)) ^ (t ^ (t >> 8)));
+    /**
+     * Convert a 64-bit output to a double on \f$(0,1]\f$.
+     */
+    static inline double to_uniform(uint64_t value) {
+        // 52 random bits as the mantissa of [1,2), which needs no
+        // int-to-float conversion and is the same in the SIMD kernels
+        const uint64_t bits = (value >> 12) | 0x3FF0000000000000ULL;
+        double one_to_two;
+        std::memcpy(&one_to_two, &bits, sizeof(double));
+        return 2. - one_to_two;
     }
 
-    ITYPE max() { return ULONG_LONG_MAX; }
-    ITYPE min() { return 0ULL; }
+    /**
+     * Combine two 32-bit words of a block into a 64-bit output.
+     */
+    static inline uint64_t to_uint64(uint32_t low, uint32_t high) {
+        return ((uint64_t)high << 32) | low;
+    }
+
+    PhiloxEngine(uint64_t seed_ = 0, uint64_t stream_ = 0)
+        : _seed(seed_),
+          _stream(stream_),
+          _offset(0),
+          _buffer_index(std::numeric_limits<uint64_t>::max()) {}
+
+    void seed(uint64_t seed_) {
+        _seed = seed_;
+        _offset = 0;
+        _buffer_index = std::numeric_limits<uint64_t>::max();
+    }
+
+    /**
+     * Move to the beginning of stream <code>stream_</code>.
+     */
+    void set_stream(uint64_t stream_) {
+        _stream = stream_;
+        _offset = 0;
+        _buffer_index = std::numeric_limits<uint64_t>::max();
+    }
 
-    XorShiftEngine(UINT seed_) { seed(seed_); }
+    /**
+     * Move to the <code>offset</code>-th 64-bit output of the current stream.
+     */
+    void set_offset(uint64_t offset) { _offset = offset; }
+
+    void discard(uint64_t count) { _offset += count; }
+
+    result_type operator()() {
+        if (_offset / 2 != _buffer_index) {
+            _buffer_index = _offset / 2;
+            _buffer = generate_block(_seed, _stream, _buffer_index);
+        }
+        const uint64_t value = (_offset % 2 == 0)
+                                   ? to_uint64(_buffer[0], _buffer[1])
+                                   : to_uint64(_buffer[2], _buffer[3]);
+        ++_offset;
+        return value;
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /**
+     * Fill <code>out</code> with <code>count</code> uniform random numbers on
+     * \f$(0,1]\f$ from the current offset, and advance the offset by
+     * <code>count</code>.
+     *
+     * Whole blocks are generated in a loop without the buffer so that the
+     * compiler can vectorize the rounds over consecutive blocks.
+     */
+    void fill_uniform(double* out, ITYPE count) {
+        ITYPE index = 0;
+        if (_offset % 2 == 1 && count > 0) {
+            out[index++] = to_uniform((*this)());
+        }
+        const uint64_t first_block_index = _offset / 2;
+        const ITYPE block_count = (count - index) / 2;
+        double* block_out = out + index;
+        for (ITYPE i = 0; i < block_count; ++i) {
+            const Block block =
+                generate_block(_seed, _stream, first_block_index + i);
+            block_out[2 * i] = to_uniform(to_uint64(block[0], block[1]));
+            block_out[2 * i + 1] = to_uniform(to_uint64(block[2], block[3]));
+        }
+        index += 2 * block_count;
+        _offset += 2 * block_count;
+        if (index < count) {
+            out[index] = to_uniform((*this)());
+        }
+    }
+
+    /**
+     * Fill <code>out</code> with <code>count</code> standard normal random
+     * numbers multiplied by <code>scale</code>.
+     *
+     * Each block gives one pair by the Box-Muller transform, so the offset is
+     * first rounded up to even, then advanced by <code>count</code> rounded
+     * up to even. With _USE_SIMD four blocks are processed at once in AVX2
+     * registers, including Philox rounds, log and sincos.
+     */
+    void fill_normal(double* out, ITYPE count, double scale = 1.);
+
+    /**
+     * Compute the sum of squares of the next <code>count</code> normal
+     * random numbers that fill_normal would generate, and advance the
+     * offset in the same way. <code>count</code> must be even.
+     *
+     * The squared radius of a Box-Muller pair is \f$-2\log u_0\f$, so the
+     * angle is not computed and nothing is written.
+     */
+    double sum_squared_normal(ITYPE count);
 };
 
 /**
@@ -44,28 +185,30 @@ public:
  */
 class Random {
 private:
-    std::uniform_real_distribution<double> uniform_dist;
     std::normal_distribution<double> normal_dist;
-    XorShiftEngine engine;
+    PhiloxEngine engine;
 
 public:
     /**
      * \~japanese-en コンストラクタ
      */
-    Random(UINT seed) : uniform_dist(0, 1), normal_dist(0, 1), engine(seed) {}
+    Random(UINT seed) : normal_dist(0, 1), engine(seed) {}
 
     /**
      * \~japanese-en シードを設定する
      *
      * @param seed シード値
      */
-    void set_seed(uint64_t seed) { engine.seed(seed); }
+    void set_seed(uint64_t seed) {
+        engine.seed(seed);
+        normal_dist.reset();
+    }
     /**
      * \~japanese-en \f$[0,1)\f$の一様分布から乱数を生成する
      *
      * @return 生成された乱数
      */
-    double uniform() { return uniform_dist(engine); }
+    double uniform() { return 1. - PhiloxEngine::to_uniform(engine()); }
 
     /**
      * \~japanese-en 期待値0、分散1の正規分から乱数を生成する
@@ -80,4 +223,4 @@ public:
      * @return 生成された乱数
      */
     uint64_t int64() { return engine(); }
-};
\ No newline at end of file
+};
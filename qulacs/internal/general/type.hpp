@@ -12,6 +12,8 @@ using UINT = unsigned int;
 
 //! complex value
 using CTYPE = std::complex<double>;
+//! single precision complex value
+using CTYPE_F32 = std::complex<float>;
 using namespace std::complex_literals;
 
 //! dimension index
@@ -0,0 +1,43 @@
+#ifdef _USE_MPI
+#include <cmath>
+
+#include "../default/init_ops.hpp"
+#include "../general/type.hpp"
+#include "init_ops.hpp"
+#include "slab_util.hpp"
+#include "stat_ops.hpp"
+
+namespace mpi {
+void initialize_quantum_state(CTYPE* state, ITYPE dim) {
+    normal::initialize_quantum_state(state, dim);
+    if (MPIutil::get_inst().get_rank() != 0) state[0] = 0.;
+}
+
+void initialize_computational_basis(
+    ITYPE comp_basis, CTYPE* state, ITYPE dim) {
+    normal::initialize_quantum_state(state, dim);
+    state[0] = 0.;
+    const ITYPE rank = MPIutil::get_inst().get_rank();
+    if ((comp_basis >> get_inner_qubit_count(dim)) == rank) {
+        state[comp_basis & (dim - 1)] = 1.;
+    }
+}
+
+void initialize_Haar_random_state(CTYPE* state, ITYPE dim, UINT seed) {
+    // the slabs are parts of one state only if they share the seed
+    seed = broadcast_seed(seed);
+    const ITYPE rank = MPIutil::get_inst().get_rank();
+    const ITYPE basis_offset = rank << get_inner_qubit_count(dim);
+    double norm = normal::Haar_random_squared_norm(dim, seed, basis_offset);
+    MPIutil::get_inst().s_D_allreduce(&norm);
+    normal::fill_Haar_random_state(
+        state, dim, seed, basis_offset, 1. / sqrt(norm));
+}
+
+void load_slab(const CTYPE* global_state, CTYPE* state, ITYPE dim) {
+    const ITYPE rank = MPIutil::get_inst().get_rank();
+    const CTYPE* slab = global_state + (rank << get_inner_qubit_count(dim));
+    normal::load_quantum_state(slab, state, dim);
+}
+}  // namespace mpi
+#endif  // #ifdef _USE_MPI
@@ -0,0 +1,33 @@
+/**
+ * @file init_ops.hpp
+ * @brief functions of initializing distributed state vector
+ *
+ * <code>state</code> is the local slab of <code>dim</code> amplitudes held
+ * by this rank, and rank r holds the amplitudes whose upper bits are r.
+ */
+
+#pragma once
+
+#include "../general/type.hpp"
+
+namespace mpi {
+DllExport void initialize_quantum_state(CTYPE* state, ITYPE dim);
+
+DllExport void initialize_computational_basis(
+    ITYPE comp_basis, CTYPE* state, ITYPE dim);
+
+/**
+ * Initialize to the Haar random state of <code>seed</code>, which is the
+ * same as the state generated by normal::initialize_Haar_random_state on a
+ * single process up to the rounding of the norm. The seed of rank 0 is
+ * used on all ranks.
+ */
+DllExport void initialize_Haar_random_state(
+    CTYPE* state, ITYPE dim, UINT seed);
+
+/**
+ * Copy the slab of this rank from the whole state vector
+ * <code>global_state</code>.
+ */
+DllExport void load_slab(const CTYPE* global_state, CTYPE* state, ITYPE dim);
+}  // namespace mpi
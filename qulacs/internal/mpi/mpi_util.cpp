@@ -1,6 +1,13 @@
 #ifdef _USE_MPI
-#include "MPIutil.hpp"
-#include "utility.hpp"
+#include "mpi_util.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 void MPIutil::MPIFunctionError(
     const std::string &func, UINT ret, const std::string &file, UINT line) {
@@ -11,9 +18,7 @@ void MPIutil::MPIFunctionError(
     std::string msg5 = file;
     std::string msg6 = ", ";
     std::string msg7 = std::to_string(line);
-    // throw MPIRuntimeException(msg1 + msg2 + msg3 + msg4 + msg5 + msg6 +
-    // msg7);
-    // TODO
+    throw std::runtime_error(msg1 + msg2 + msg3 + msg4 + msg5 + msg6 + msg7);
 }
 
 MPI_Request *MPIutil::get_request() {
@@ -22,8 +27,7 @@ MPI_Request *MPIutil::get_request() {
         std::string msg2 = __FILE__;
         std::string msg3 = ", ";
         std::string msg4 = std::to_string(__LINE__);
-        // throw MPIRuntimeException(msg1 + msg2 + msg3 + msg4);
-        // TODO
+        throw std::runtime_error(msg1 + msg2 + msg3 + msg4);
     }
 
     mpireq_cnt++;
@@ -42,9 +46,8 @@ void MPIutil::mpi_wait(UINT count) {
         std::string msg6 = __FILE__;
         std::string msg7 = ", ";
         std::string msg8 = std::to_string(__LINE__);
-        // throw MPIRuntimeException(
-        // msg1 + msg2 + msg3 + msg4 + msg5 + msg6 + msg7 + msg8);
-        // TODO
+        throw std::runtime_error(
+            msg1 + msg2 + msg3 + msg4 + msg5 + msg6 + msg7 + msg8);
     }
 
     for (UINT i = 0; i < count; i++) {
@@ -56,14 +59,131 @@ void MPIutil::mpi_wait(UINT count) {
     }
 }
 
+void MPIutil::split_active_ranks() {
+    UINT ret = MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+    if (ret != MPI_SUCCESS)
+        MPIFunctionError("MPI_Comm_rank", ret, __FILE__, __LINE__);
+    ret = MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+    if (ret != MPI_SUCCESS)
+        MPIFunctionError("MPI_Comm_size", ret, __FILE__, __LINE__);
+
+    // a node is a group of ranks that can share memory
+    MPI_Comm nodecomm;
+    ret = MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED,
+        world_rank, MPI_INFO_NULL, &nodecomm);
+    if (ret != MPI_SUCCESS)
+        MPIFunctionError("MPI_Comm_split_type", ret, __FILE__, __LINE__);
+    MPI_Comm_rank(nodecomm, &node_rank);
+    MPI_Comm_size(nodecomm, &node_size);
+    int node_leader = world_rank;
+    MPI_Bcast(&node_leader, 1, MPI_INT, 0, nodecomm);
+    MPI_Comm_free(&nodecomm);
+
+    int own[2] = {node_leader, node_rank};
+    std::vector<int> all(2 * world_size);
+    ret = MPI_Allgather(
+        own, 2, MPI_INT, all.data(), 2, MPI_INT, MPI_COMM_WORLD);
+    if (ret != MPI_SUCCESS)
+        MPIFunctionError("MPI_Allgather<int>", ret, __FILE__, __LINE__);
+    std::vector<int> leader_list;
+    for (int r = 0; r < world_size; ++r) leader_list.push_back(all[2 * r]);
+    std::sort(leader_list.begin(), leader_list.end());
+    leader_list.erase(std::unique(leader_list.begin(), leader_list.end()),
+        leader_list.end());
+    node_count = leader_list.size();
+    auto get_node_index_of = [&](int r) -> int {
+        return std::lower_bound(leader_list.begin(), leader_list.end(),
+                   all[2 * r]) -
+               leader_list.begin();
+    };
+    node_index = get_node_index_of(world_rank);
+
+    // take ranks with node rank 0 from every node, then node rank 1, and so
+    // on, until the largest power of 2 not above the number of ranks
+    int active_size = 1;
+    while (active_size * 2 <= world_size) active_size *= 2;
+    std::vector<std::pair<int, int>> order;  // (node rank, node index)
+    for (int r = 0; r < world_size; ++r) {
+        order.emplace_back(all[2 * r + 1], get_node_index_of(r));
+    }
+    std::vector<int> world_rank_list(world_size);
+    for (int r = 0; r < world_size; ++r) world_rank_list[r] = r;
+    std::stable_sort(world_rank_list.begin(), world_rank_list.end(),
+        [&](int lhs, int rhs) { return order[lhs] < order[rhs]; });
+    std::vector<bool> is_active_list(world_size, false);
+    std::vector<std::vector<int>> node_active_list(node_count);
+    for (int i = 0; i < active_size; ++i) {
+        const int r = world_rank_list[i];
+        is_active_list[r] = true;
+        node_active_list[get_node_index_of(r)].push_back(r);
+    }
+    node_active_size = node_active_list[node_index].size();
+
+    // split the active ranks of each node into power-of-2 blocks and number
+    // the blocks from the largest. Every block then starts at a multiple of
+    // its size, so a block of 2^k ranks holds all values of the lower k
+    // outer qubits and pairs on those qubits stay in the node.
+    std::vector<std::array<int, 3>> block_list;  // (-size, node, first)
+    for (int n = 0; n < node_count; ++n) {
+        const int count = node_active_list[n].size();
+        int first = 0;
+        for (int size = active_size; size > 0; size /= 2) {
+            if (count & size) {
+                block_list.push_back({-size, n, first});
+                first += size;
+            }
+        }
+    }
+    std::sort(block_list.begin(), block_list.end());
+    int key = 0;
+    int position = 0;
+    for (const std::array<int, 3> &block : block_list) {
+        for (int i = 0; i < -block[0]; ++i, ++position) {
+            if (node_active_list[block[1]][block[2] + i] == world_rank) {
+                key = position;
+            }
+        }
+    }
+
+    const int color = is_active_list[world_rank] ? 0 : MPI_UNDEFINED;
+    ret = MPI_Comm_split(MPI_COMM_WORLD, color, key, &mpicomm);
+    if (ret != MPI_SUCCESS)
+        MPIFunctionError("MPI_Comm_split", ret, __FILE__, __LINE__);
+    if (mpicomm != MPI_COMM_NULL) {
+        MPI_Comm_rank(mpicomm, &mpirank);
+        MPI_Comm_size(mpicomm, &mpisize);
+    } else {
+        mpirank = -1;
+        mpisize = active_size;
+    }
+}
+
 int MPIutil::get_rank() { return mpirank; }
 
 int MPIutil::get_size() { return mpisize; }
 
+bool MPIutil::is_active() { return mpicomm != MPI_COMM_NULL; }
+
+int MPIutil::get_world_rank() { return world_rank; }
+
+int MPIutil::get_world_size() { return world_size; }
+
+int MPIutil::get_node_count() { return node_count; }
+
+int MPIutil::get_node_index() { return node_index; }
+
+int MPIutil::get_node_rank() { return node_rank; }
+
+int MPIutil::get_node_size() { return node_size; }
+
+int MPIutil::get_node_active_size() { return node_active_size; }
+
 int MPIutil::get_tag() {
-    // pthread_mutex_lock(&mutex);
-    mpitag ^= 1 << 20;  // max 1M-ranks
-    // pthread_mutex_unlock(&mutex);
+    // The tag does not change between calls. A rank may skip an exchange
+    // that its pair also skips (e.g. a gate controlled by an outer qubit),
+    // so a tag toggled per call would get out of step between ranks. MPI
+    // keeps the order of messages between a pair, which is enough to match
+    // successive exchanges.
     return mpitag;
 }
 
@@ -72,24 +192,43 @@ void MPIutil::release_workarea() {
     workarea = NULL;
 }
 
+void MPIutil::set_workarea(UINT nqubit, UINT depth) {
+    if (nqubit == 0 || nqubit > 30) {
+        throw std::invalid_argument(
+            "the chunk of the workarea must have 1 to 30 qubits.");
+    }
+    if (depth == 0 || depth > _MAX_PIPELINE_DEPTH) {
+        throw std::invalid_argument("the pipeline depth must be 1 to " +
+                                    std::to_string(_MAX_PIPELINE_DEPTH) + ".");
+    }
+    if (mpireq_cnt != 0) {
+        throw std::runtime_error(
+            "cannot resize the workarea with incompleted requests.");
+    }
+    work_nqubit = nqubit;
+    pipeline_depth = depth;
+    release_workarea();
+}
+
 CTYPE *MPIutil::get_workarea(ITYPE *dim_work, ITYPE *num_work) {
+    // a send and a receive buffer of dim_work for each chunk in flight
     ITYPE dim = *dim_work;
-    *dim_work = get_min_ll(1 << _NQUBIT_WORK, dim);
-    *num_work = get_max_ll(1, dim >> _NQUBIT_WORK);
+    *dim_work = std::min((ITYPE)1 << work_nqubit, dim);
+    *num_work = std::max((ITYPE)1, dim >> work_nqubit);
     if (workarea == NULL) {
+        const size_t size =
+            sizeof(CTYPE) * 2 * pipeline_depth * ((size_t)1 << work_nqubit);
 #if defined(__ARM_FEATURE_SVE)
-        posix_memalign(
-            (void **)&workarea, 256, sizeof(CTYPE) * (1 << _NQUBIT_WORK));
+        posix_memalign((void **)&workarea, 256, size);
 #else
-        workarea = (CTYPE *)malloc(sizeof(CTYPE) * (1 << _NQUBIT_WORK));
+        workarea = (CTYPE *)malloc(size);
 #endif
         if (workarea == NULL) {
             std::string msg1 = "Can't malloc in get_workarea for MPI, ";
             std::string msg2 = __FILE__;
             std::string msg3 = ", ";
             std::string msg4 = std::to_string(__LINE__);
-            // throw MPIRuntimeException(msg1 + msg2 + msg3 + msg4);
-            // TODO
+            throw std::runtime_error(msg1 + msg2 + msg3 + msg4);
         }
     }
     return workarea;
@@ -178,6 +317,13 @@ void MPIutil::m_I_allreduce(void *buf, UINT count) {
         MPIFunctionError("MPI_Allreduce<ITYPE>", ret, __FILE__, __LINE__);
 }
 
+void MPIutil::m_D_allreduce(void *buf, UINT count) {
+    UINT ret = MPI_Allreduce(
+        MPI_IN_PLACE, buf, count, MPI_DOUBLE, MPI_SUM, mpicomm);
+    if (ret != MPI_SUCCESS)
+        MPIFunctionError("MPI_Allreduce<DOUBLE>", ret, __FILE__, __LINE__);
+}
+
 void MPIutil::s_D_allreduce(void *buf) {
     UINT ret =
         MPI_Allreduce(MPI_IN_PLACE, buf, 1, MPI_DOUBLE, MPI_SUM, mpicomm);
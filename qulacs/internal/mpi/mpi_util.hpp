@@ -6,21 +6,46 @@
 #ifdef _USE_MPI
 #include <mpi.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <string>
 
 #include "../general/type.hpp"
 
-#define _NQUBIT_WORK 22  // 4 Mi x 16 Byte(CTYPE)
-#define _MAX_REQUESTS 4  // 2 (isend/irecv) * 2 (double buffering)
+#define _NQUBIT_WORK 20  // 1 Mi x 16 Byte(CTYPE) per chunk
+#define _PIPELINE_DEPTH 2  // double buffering
+#define _MAX_PIPELINE_DEPTH 4
+#define _MAX_REQUESTS (2 * _MAX_PIPELINE_DEPTH)  // isend/irecv per chunk
 
+/**
+ * Communication of StateVector<MPI>.
+ *
+ * The state is distributed over the largest power of 2 of the ranks of
+ * MPI_COMM_WORLD, called active ranks. They are taken evenly from the
+ * nodes found by MPI_COMM_TYPE_SHARED. The active ranks of a node are split
+ * into power-of-2 blocks, numbered from the largest, so that the pairs on
+ * the lower k outer qubits of a block of 2^k ranks stay in a node. get_rank
+ * and get_size refer to the active ranks, and the other ranks must not use
+ * the collectives.
+ */
 class MPIutil {
 private:
-    MPI_Comm mpicomm = 0;
-    int mpirank = 0;
+    MPI_Comm mpicomm = MPI_COMM_NULL;
+    int mpirank = -1;
     int mpisize = 0;
     int mpitag = 0;
+    int world_rank = 0;
+    int world_size = 0;
+    int node_count = 0;
+    int node_index = 0;
+    int node_rank = 0;
+    int node_size = 0;
+    int node_active_size = 0;
     MPI_Status mpistat;
     CTYPE *workarea = NULL;
+    UINT work_nqubit = _NQUBIT_WORK;
+    UINT pipeline_depth = _PIPELINE_DEPTH;
     MPI_Request mpireq[_MAX_REQUESTS];
     UINT mpireq_idx = 0;
     UINT mpireq_cnt = 0;
@@ -28,16 +53,21 @@ private:
     static void MPIFunctionError(
         const std::string &func, UINT ret, const std::string &file, UINT line);
 
+    void split_active_ranks();
+
     MPIutil() {
-        mpicomm = MPI_COMM_WORLD;
-        UINT ret;
-        ret = MPI_Comm_rank(mpicomm, &mpirank);
-        if (ret != MPI_SUCCESS)
-            MPIFunctionError("MPI_Comm_rank", ret, __FILE__, __LINE__);
-        ret = MPI_Comm_size(mpicomm, &mpisize);
-        if (ret != MPI_SUCCESS)
-            MPIFunctionError("MPI_Comm_size", ret, __FILE__, __LINE__);
+        split_active_ranks();
         mpitag = 0;
+
+        if (const char *tmp = std::getenv("QULACS_MPI_WORK_NQUBIT")) {
+            const UINT tmp_val = strtol(tmp, nullptr, 0);
+            if (0 < tmp_val && tmp_val <= 30) work_nqubit = tmp_val;
+        }
+        if (const char *tmp = std::getenv("QULACS_MPI_PIPELINE_DEPTH")) {
+            const UINT tmp_val = strtol(tmp, nullptr, 0);
+            if (0 < tmp_val && tmp_val <= _MAX_PIPELINE_DEPTH)
+                pipeline_depth = tmp_val;
+        }
     }
     ~MPIutil() = default;
 
@@ -55,9 +85,19 @@ public:
     MPI_Request *get_request();
     int get_rank();
     int get_size();
+    bool is_active();
+    int get_world_rank();
+    int get_world_size();
+    int get_node_count();
+    int get_node_index();
+    int get_node_rank();
+    int get_node_size();
+    int get_node_active_size();
     int get_tag();
     CTYPE *get_workarea(ITYPE *dim_work, ITYPE *num_work);
     void release_workarea();
+    // overrides QULACS_MPI_WORK_NQUBIT and QULACS_MPI_PIPELINE_DEPTH
+    void set_workarea(UINT nqubit, UINT depth);
     void barrier();
     void mpi_wait(UINT count);
     void m_DC_allgather(void *sendbuf, void *recvbuf, int count);
@@ -67,10 +107,50 @@ public:
     void m_DC_sendrecv_replace(void *buf, int count, int pair_rank);
     void m_DC_isendrecv(void *sendbuf, void *recvbuf, int count, int pair_rank);
     void m_I_allreduce(void *buf, UINT count);
+    void m_D_allreduce(void *buf, UINT count);
     void s_D_allgather(double a, void *recvbuf);
     void s_D_allreduce(void *buf);
     void s_DC_allreduce(void *buf);
     void s_u_bcast(UINT *a);
     void s_D_bcast(double *a);
+
+    /**
+     * Exchange <code>dim</code> amplitudes with <code>pair_rank</code> in
+     * chunks of the workarea, keeping up to the pipeline depth of chunks in
+     * flight so that the transfer of the next chunks overlaps the kernel on
+     * the received one.
+     *
+     * <code>pack(begin, chunk_dim, buffer)</code> returns the chunk
+     * [begin, begin + chunk_dim) to send, either in place or copied into
+     * <code>buffer</code>. It must not be modified until the kernel of the
+     * chunk is called. <code>kernel(begin, chunk_dim, received)</code>
+     * consumes the same chunk of the pair. With a pipeline depth of 1, the
+     * exchange and the kernel are serialized.
+     */
+    template <class Pack, class Kernel>
+    void m_DC_sendrecv_pipeline(
+        ITYPE dim, int pair_rank, Pack pack, Kernel kernel) {
+        ITYPE dim_work = dim, num_work = 0;
+        CTYPE *work = get_workarea(&dim_work, &num_work);
+        const ITYPE depth = std::min((ITYPE)pipeline_depth, num_work);
+        // slot k holds the send buffer and then the receive buffer
+        auto post = [&](ITYPE work_index) {
+            CTYPE *buffer = work + 2 * (work_index % depth) * dim_work;
+            const CTYPE *sendbuf =
+                pack(work_index * dim_work, dim_work, buffer);
+            m_DC_isendrecv((void *)sendbuf, buffer + dim_work, dim_work,
+                pair_rank);
+        };
+        for (ITYPE work_index = 0; work_index < depth; ++work_index) {
+            post(work_index);
+        }
+        for (ITYPE work_index = 0; work_index < num_work; ++work_index) {
+            // the oldest two requests are the isend/irecv of this chunk
+            mpi_wait(2);
+            kernel(work_index * dim_work, dim_work,
+                work + (2 * (work_index % depth) + 1) * dim_work);
+            if (work_index + depth < num_work) post(work_index + depth);
+        }
+    }
 };
 #endif
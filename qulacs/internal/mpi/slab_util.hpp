@@ -0,0 +1,58 @@
+/**
+ * @file slab_util.hpp
+ * @brief utility for the local slab of a distributed state vector
+ *
+ * Rank r holds the <code>dim</code> amplitudes whose upper bits are r. A
+ * qubit below log2(dim) is inner and the others are outer.
+ */
+
+#pragma once
+
+#ifdef _USE_MPI
+#include "../general/type.hpp"
+#include "mpi_util.hpp"
+
+namespace mpi {
+/**
+ * Number of inner qubits of a slab of <code>dim</code> amplitudes.
+ */
+inline static UINT get_inner_qubit_count(ITYPE dim) {
+    UINT inner_qc = 0;
+    while (((ITYPE)1 << inner_qc) < dim) ++inner_qc;
+    return inner_qc;
+}
+
+/**
+ * Value of outer qubit <code>qubit_index</code> on this rank.
+ */
+inline static UINT get_outer_bit(UINT qubit_index, ITYPE dim) {
+    const UINT rank = MPIutil::get_inst().get_rank();
+    return (rank >> (qubit_index - get_inner_qubit_count(dim))) & 1;
+}
+
+/**
+ * Rank that differs from this rank only in outer qubit
+ * <code>qubit_index</code>.
+ */
+inline static int get_pair_rank(UINT qubit_index, ITYPE dim) {
+    const UINT rank = MPIutil::get_inst().get_rank();
+    return rank ^ (1U << (qubit_index - get_inner_qubit_count(dim)));
+}
+
+/**
+ * Exchange the whole slab with <code>pair_rank</code> through the workarea,
+ * one chunk at a time. <code>kernel(chunk, received, chunk_dim)</code>
+ * updates a chunk of the local slab from the same chunk of the pair, while
+ * the next chunks are in flight.
+ */
+template <class Kernel>
+void exchange_slab(CTYPE* state, ITYPE dim, int pair_rank, Kernel kernel) {
+    MPIutil::get_inst().m_DC_sendrecv_pipeline(
+        dim, pair_rank,
+        [state](ITYPE begin, ITYPE, CTYPE*) { return state + begin; },
+        [&](ITYPE begin, ITYPE chunk_dim, const CTYPE* received) {
+            kernel(state + begin, received, chunk_dim);
+        });
+}
+}  // namespace mpi
+#endif
@@ -0,0 +1,253 @@
+#ifdef _USE_MPI
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../default/stat_ops.hpp"
+#include "../general/random.hpp"
+#include "../general/type.hpp"
+#include "slab_util.hpp"
+#include "stat_ops.hpp"
+
+namespace mpi {
+UINT broadcast_seed(UINT seed) {
+    MPIutil::get_inst().s_u_bcast(&seed);
+    return seed;
+}
+
+double m0_prob(const CTYPE* state, ITYPE dim, UINT target_qubit_index) {
+    double result = 0.;
+    if (target_qubit_index < get_inner_qubit_count(dim)) {
+        result = normal::m0_prob(state, dim, target_qubit_index);
+    } else if (get_outer_bit(target_qubit_index, dim) == 0) {
+        result = normal::state_norm_squared(state, dim);
+    }
+    MPIutil::get_inst().s_D_allreduce(&result);
+    return result;
+}
+
+double marginal_prob(const CTYPE* state, ITYPE dim,
+    const std::vector<UINT>& sorted_target_qubit_index_list,
+    const std::vector<UINT>& measured_value_list) {
+    const UINT inner_qc = get_inner_qubit_count(dim);
+    std::vector<UINT> inner_target_list, inner_value_list;
+    bool is_matched = true;
+    for (UINT i = 0; i < sorted_target_qubit_index_list.size(); ++i) {
+        const UINT target_qubit_index = sorted_target_qubit_index_list[i];
+        if (target_qubit_index < inner_qc) {
+            inner_target_list.push_back(target_qubit_index);
+            inner_value_list.push_back(measured_value_list[i]);
+        } else if (get_outer_bit(target_qubit_index, dim) !=
+                   measured_value_list[i]) {
+            is_matched = false;
+        }
+    }
+    double result = 0.;
+    if (is_matched) {
+        result = normal::marginal_prob(
+            state, dim, inner_target_list, inner_value_list);
+    }
+    MPIutil::get_inst().s_D_allreduce(&result);
+    return result;
+}
+
+std::vector<double> zero_probabilities(
+    const CTYPE* state, ITYPE dim, UINT qubit_count) {
+    const UINT inner_qc = get_inner_qubit_count(dim);
+    std::vector<double> result = normal::zero_probabilities(state, dim);
+    result.resize(qubit_count, 0.);
+    const double norm = normal::state_norm_squared(state, dim);
+    for (UINT qubit_index = inner_qc; qubit_index < qubit_count;
+         ++qubit_index) {
+        if (get_outer_bit(qubit_index, dim) == 0) result[qubit_index] = norm;
+    }
+    MPIutil::get_inst().m_D_allreduce(result.data(), qubit_count);
+    return result;
+}
+
+std::vector<double> marginal_distribution(const CTYPE* state, ITYPE dim,
+    const std::vector<UINT>& target_qubit_index_list) {
+    const UINT inner_qc = get_inner_qubit_count(dim);
+    const UINT target_count = target_qubit_index_list.size();
+    // outcome bits of outer targets are fixed on this rank
+    std::vector<UINT> inner_target_list, inner_position_list;
+    ITYPE outer_outcome = 0;
+    for (UINT cursor = 0; cursor < target_count; ++cursor) {
+        const UINT target_qubit_index = target_qubit_index_list[cursor];
+        if (target_qubit_index < inner_qc) {
+            inner_target_list.push_back(target_qubit_index);
+            inner_position_list.push_back(cursor);
+        } else {
+            outer_outcome |= (ITYPE)get_outer_bit(target_qubit_index, dim)
+                             << cursor;
+        }
+    }
+    const std::vector<double> local_result =
+        normal::marginal_distribution(state, dim, inner_target_list);
+
+    std::vector<double> result((ITYPE)1 << target_count, 0.);
+    for (ITYPE local_outcome = 0; local_outcome < local_result.size();
+         ++local_outcome) {
+        ITYPE outcome = outer_outcome;
+        for (UINT i = 0; i < inner_position_list.size(); ++i) {
+            outcome |= ((local_outcome >> i) & 1) << inner_position_list[i];
+        }
+        result[outcome] = local_result[local_outcome];
+    }
+    MPIutil::get_inst().m_D_allreduce(result.data(), result.size());
+    return result;
+}
+
+double measurement_distribution_entropy(const CTYPE* state, ITYPE dim) {
+    double result = normal::measurement_distribution_entropy(state, dim);
+    MPIutil::get_inst().s_D_allreduce(&result);
+    return result;
+}
+
+double state_norm_squared(const CTYPE* state, ITYPE dim) {
+    double result = normal::state_norm_squared(state, dim);
+    MPIutil::get_inst().s_D_allreduce(&result);
+    return result;
+}
+
+void fused_statistics(const CTYPE* state, ITYPE dim, UINT qubit_count,
+    bool compute_entropy, bool compute_zero_probability,
+    const std::vector<ITYPE>& marginal_mask_list,
+    const std::vector<ITYPE>& marginal_value_list, double& squared_norm,
+    double& entropy, std::vector<double>& zero_probability_list,
+    std::vector<double>& marginal_probability_list) {
+    const UINT inner_qc = get_inner_qubit_count(dim);
+    const ITYPE inner_mask = dim - 1;
+    const ITYPE rank = MPIutil::get_inst().get_rank();
+    const ITYPE outer_value = rank << inner_qc;
+    const UINT marginal_count = marginal_mask_list.size();
+
+    std::vector<ITYPE> inner_mask_list(marginal_count);
+    std::vector<ITYPE> inner_value_list(marginal_count);
+    for (UINT m = 0; m < marginal_count; ++m) {
+        inner_mask_list[m] = marginal_mask_list[m] & inner_mask;
+        inner_value_list[m] = marginal_value_list[m] & inner_mask;
+    }
+    normal::fused_statistics(state, dim, compute_entropy,
+        compute_zero_probability, inner_mask_list, inner_value_list,
+        squared_norm, entropy, zero_probability_list,
+        marginal_probability_list);
+
+    if (compute_zero_probability) {
+        zero_probability_list.resize(qubit_count, 0.);
+        for (UINT qubit_index = inner_qc; qubit_index < qubit_count;
+             ++qubit_index) {
+            if (get_outer_bit(qubit_index, dim) == 0) {
+                zero_probability_list[qubit_index] = squared_norm;
+            }
+        }
+    }
+    for (UINT m = 0; m < marginal_count; ++m) {
+        if ((outer_value & marginal_mask_list[m]) !=
+            (marginal_value_list[m] & ~inner_mask)) {
+            marginal_probability_list[m] = 0.;
+        }
+    }
+
+    // pack every result into one buffer for a single allreduce
+    std::vector<double> buffer = {squared_norm, entropy};
+    buffer.insert(buffer.end(), zero_probability_list.begin(),
+        zero_probability_list.end());
+    buffer.insert(buffer.end(), marginal_probability_list.begin(),
+        marginal_probability_list.end());
+    MPIutil::get_inst().m_D_allreduce(buffer.data(), buffer.size());
+    squared_norm = buffer[0];
+    entropy = buffer[1];
+    std::copy(buffer.begin() + 2,
+        buffer.begin() + 2 + zero_probability_list.size(),
+        zero_probability_list.begin());
+    std::copy(buffer.end() - marginal_count, buffer.end(),
+        marginal_probability_list.begin());
+}
+
+std::vector<ITYPE> sampling(
+    const CTYPE* state, ITYPE dim, UINT sampling_count, UINT seed) {
+    MPIutil& mpiutil = MPIutil::get_inst();
+    const UINT rank = mpiutil.get_rank();
+    const UINT size = mpiutil.get_size();
+    // the uniforms and the shuffle have to be the same on all ranks
+    seed = broadcast_seed(seed);
+    const std::vector<double> block_offset =
+        normal::sampling_block_offset(state, dim);
+    std::vector<double> rank_offset(size + 1, 0.);
+    mpiutil.s_D_allgather(block_offset.back(), rank_offset.data() + 1);
+    for (UINT r = 0; r < size; ++r) rank_offset[r + 1] += rank_offset[r];
+
+    const std::vector<double> uniforms = normal::generate_sorted_uniforms(
+        sampling_count, rank_offset[size], seed);
+    // the uniforms in [rank_offset[rank], rank_offset[rank + 1]) fall in the
+    // slab of this rank. the last rank also takes the ones left by rounding
+    auto find_uniform = [&](double value) -> ITYPE {
+        return std::lower_bound(uniforms.begin(), uniforms.end(), value) -
+               uniforms.begin();
+    };
+    const ITYPE begin = (rank == 0) ? 0 : find_uniform(rank_offset[rank]);
+    const ITYPE end = (rank + 1 == size) ? sampling_count
+                                         : find_uniform(rank_offset[rank + 1]);
+
+    // other ranks leave 0 in the range of this rank, so a sum gathers them
+    std::vector<ITYPE> samples(sampling_count, 0);
+    if (begin < end) {
+        normal::sample_sorted_uniforms(state, dim, block_offset,
+            uniforms.data() + begin, end - begin, rank_offset[rank],
+            samples.data() + begin);
+        const ITYPE basis_offset = (ITYPE)rank << get_inner_qubit_count(dim);
+        for (ITYPE i = begin; i < end; ++i) samples[i] += basis_offset;
+    }
+    mpiutil.m_I_allreduce(samples.data(), sampling_count);
+    normal::shuffle_samples(samples, seed);
+    return samples;
+}
+
+std::vector<ITYPE> local_sampling(
+    const CTYPE* state, ITYPE dim, UINT sampling_count, UINT seed) {
+    MPIutil& mpiutil = MPIutil::get_inst();
+    const UINT rank = mpiutil.get_rank();
+    const UINT size = mpiutil.get_size();
+    const std::vector<double> block_offset =
+        normal::sampling_block_offset(state, dim);
+    std::vector<double> rank_norm(size);
+    mpiutil.s_D_allgather(block_offset.back(), rank_norm.data());
+
+    // the split adds up to sampling_count only if all ranks draw the same
+    seed = broadcast_seed(seed);
+    // the key above 2^32 keeps this apart from the streams of the normal
+    // kernels, which use the 32-bit seed as the key
+    PhiloxEngine engine(((uint64_t)1 << 32) | seed);
+    double remaining_norm = 0.;
+    for (UINT r = 0; r < size; ++r) remaining_norm += rank_norm[r];
+    ITYPE remaining_count = sampling_count;
+    ITYPE local_count = 0;
+    for (UINT r = 0; r < size && remaining_count > 0; ++r) {
+        // a binomial split conditioned on the ranks before gives a
+        // multinomial split. the last rank takes the rest
+        ITYPE count = remaining_count;
+        if (r + 1 < size && rank_norm[r] < remaining_norm) {
+            std::binomial_distribution<ITYPE> binomial(
+                remaining_count, std::max(rank_norm[r], 0.) / remaining_norm);
+            count = binomial(engine);
+        }
+        if (r == rank) local_count = count;
+        remaining_count -= count;
+        remaining_norm -= rank_norm[r];
+    }
+    const UINT local_seed = (UINT)(engine() >> 32) + rank;
+
+    std::vector<ITYPE> samples(local_count);
+    if (local_count == 0) return samples;
+    const std::vector<double> uniforms = normal::generate_sorted_uniforms(
+        local_count, block_offset.back(), local_seed);
+    normal::sample_sorted_uniforms(state, dim, block_offset, uniforms.data(),
+        local_count, 0., samples.data());
+    const ITYPE basis_offset = (ITYPE)rank << get_inner_qubit_count(dim);
+    for (ITYPE& sample : samples) sample += basis_offset;
+    normal::shuffle_samples(samples, local_seed);
+    return samples;
+}
+}  // namespace mpi
+#endif  // #ifdef _USE_MPI
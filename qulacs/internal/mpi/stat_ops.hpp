@@ -0,0 +1,82 @@
+/**
+ * @file stat_ops.hpp
+ * @brief functions of measuring distributed state vector
+ *
+ * <code>state</code> is the local slab of <code>dim</code> amplitudes held
+ * by this rank, and rank r holds the amplitudes whose upper bits are r.
+ * Each rank reduces its slab with the kernels of normal, then the partial
+ * results are summed over ranks. Every rank gets the same result.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "../general/type.hpp"
+
+namespace mpi {
+DllExport double m0_prob(
+    const CTYPE* state, ITYPE dim, UINT target_qubit_index);
+
+DllExport double marginal_prob(const CTYPE* state, ITYPE dim,
+    const std::vector<UINT>& sorted_target_qubit_index_list,
+    const std::vector<UINT>& measured_value_list);
+
+/**
+ * Compute the probability of observing 0 on each of the
+ * <code>qubit_count</code> qubits.
+ */
+DllExport std::vector<double> zero_probabilities(
+    const CTYPE* state, ITYPE dim, UINT qubit_count);
+
+DllExport std::vector<double> marginal_distribution(const CTYPE* state,
+    ITYPE dim, const std::vector<UINT>& target_qubit_index_list);
+
+DllExport double measurement_distribution_entropy(
+    const CTYPE* state, ITYPE dim);
+
+DllExport double state_norm_squared(const CTYPE* state, ITYPE dim);
+
+/**
+ * Compute several statistics in a single sweep of each slab, and sum them
+ * over ranks in a single allreduce. The arguments are the same as
+ * normal::fused_statistics except <code>qubit_count</code>.
+ */
+DllExport void fused_statistics(const CTYPE* state, ITYPE dim,
+    UINT qubit_count, bool compute_entropy, bool compute_zero_probability,
+    const std::vector<ITYPE>& marginal_mask_list,
+    const std::vector<ITYPE>& marginal_value_list, double& squared_norm,
+    double& entropy, std::vector<double>& zero_probability_list,
+    std::vector<double>& marginal_probability_list);
+
+/**
+ * Seed given on active rank 0. A seed drawing random numbers that have to
+ * agree over the ranks is broadcast first, because the default seed
+ * (UINT)time(nullptr) can differ between ranks.
+ */
+DllExport UINT broadcast_seed(UINT seed);
+
+/**
+ * Sample computational basis.
+ *
+ * The norms of the slabs are gathered, and every rank generates the same
+ * sorted uniforms from the seed of rank 0. Each rank maps the uniforms in the range of its slab,
+ * and the samples are summed over ranks, then shuffled. The result is the
+ * same on all ranks.
+ */
+DllExport std::vector<ITYPE> sampling(
+    const CTYPE* state, ITYPE dim, UINT sampling_count, UINT seed);
+
+/**
+ * Sample computational basis, returning only the samples in the slab of
+ * this rank.
+ *
+ * The norms of the slabs are gathered, and every rank draws the same
+ * multinomial split of <code>sampling_count</code> shots over the ranks
+ * from the seed of rank 0. Each rank then samples its own shots from its
+ * slab with its own seed, so no rank holds more than its own samples. The samples of all ranks follow
+ * the same distribution as sampling.
+ */
+DllExport std::vector<ITYPE> local_sampling(
+    const CTYPE* state, ITYPE dim, UINT sampling_count, UINT seed);
+}  // namespace mpi
@@ -0,0 +1,21 @@
+#ifdef _USE_MPI
+#include "../default/state_ops.hpp"
+#include "../general/type.hpp"
+#include "slab_util.hpp"
+#include "state_ops.hpp"
+
+namespace mpi {
+CTYPE inner_product(
+    const CTYPE* state_bra, const CTYPE* state_ket, ITYPE dim) {
+    CTYPE result = normal::inner_product(state_bra, state_ket, dim);
+    MPIutil::get_inst().s_DC_allreduce(&result);
+    return result;
+}
+
+void gather_slab(const CTYPE* state, ITYPE dim, CTYPE* global_state) {
+    // the send buffer of MPI_Allgather is not const in MPI-2
+    MPIutil::get_inst().m_DC_allgather(
+        const_cast<CTYPE*>(state), global_state, dim);
+}
+}  // namespace mpi
+#endif  // #ifdef _USE_MPI
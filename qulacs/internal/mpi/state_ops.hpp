@@ -0,0 +1,26 @@
+/**
+ * @file state_ops.hpp
+ * @brief functions of combining distributed state vectors
+ *
+ * <code>state</code> is the local slab of <code>dim</code> amplitudes held
+ * by this rank, and rank r holds the amplitudes whose upper bits are r.
+ */
+
+#pragma once
+
+#include "../general/type.hpp"
+
+namespace mpi {
+/**
+ * Compute <bra|ket> as the sum of the inner products of the slabs.
+ */
+DllExport CTYPE inner_product(
+    const CTYPE* state_bra, const CTYPE* state_ket, ITYPE dim);
+
+/**
+ * Gather the slabs of all ranks into <code>global_state</code>, which has
+ * dim times the number of ranks amplitudes.
+ */
+DllExport void gather_slab(
+    const CTYPE* state, ITYPE dim, CTYPE* global_state);
+}  // namespace mpi
@@ -0,0 +1,71 @@
+/**
+ * @file update_ops.hpp
+ * @brief functions of updating distributed state vector
+ *
+ * <code>state</code> is the local slab of <code>dim</code> amplitudes held
+ * by this rank. Rank r holds the amplitudes whose upper bits are r, so a
+ * qubit below log2(dim) is inner and the others are outer. Gates on inner
+ * qubits run the kernels of normal on the slab. Diagonal gates on outer
+ * qubits scale the whole slab, and the others exchange the slab with the
+ * rank that differs in the outer qubit.
+ *
+ * Every rank must call the same functions with the same arguments.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "../general/type.hpp"
+
+namespace mpi {
+DllExport void project_and_normalize(
+    ITYPE mask, ITYPE value, double norm, CTYPE* state, ITYPE dim);
+
+DllExport void single_qubit_dense_matrix_gate(UINT target_qubit_index,
+    const CTYPE matrix[4], CTYPE* state, ITYPE dim);
+
+/**
+ * Apply a dense matrix with control qubits.
+ *
+ * A rank whose outer qubits do not match the control values does nothing.
+ * Each outer target is swapped with an inner qubit not used by the gate,
+ * so the number of inner qubits must be at least the number of targets and
+ * controls.
+ */
+DllExport void multi_qubit_control_multi_qubit_dense_matrix_gate(
+    const std::vector<UINT>& control_qubit_index_list,
+    const std::vector<UINT>& control_value_list,
+    const std::vector<UINT>& target_qubit_index_list,
+    const std::vector<CTYPE>& matrix, CTYPE* state, ITYPE dim);
+
+DllExport void single_qubit_diagonal_matrix_gate(UINT target_qubit_index,
+    const CTYPE diagonal_matrix[2], CTYPE* state, ITYPE dim);
+
+DllExport void single_qubit_phase_gate(
+    UINT target_qubit_index, CTYPE phase, CTYPE* state, ITYPE dim);
+
+DllExport void X_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+DllExport void Y_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+DllExport void Z_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+DllExport void S_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+DllExport void Sdag_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+DllExport void T_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+DllExport void Tdag_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+DllExport void P0_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+DllExport void P1_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim);
+
+/**
+ * Swap two qubits.
+ *
+ * For an inner and an outer qubit, a rank sends the half of the slab whose
+ * inner qubit differs from its outer qubit, and receives the same half from
+ * the pair. For two outer qubits, ranks whose two bits differ exchange the
+ * whole slab.
+ */
+DllExport void SWAP_gate(UINT target_qubit_index_0, UINT target_qubit_index_1,
+    CTYPE* state, ITYPE dim);
+
+DllExport void RZ_gate(
+    UINT target_qubit_index, double angle, CTYPE* state, ITYPE dim);
+}  // namespace mpi
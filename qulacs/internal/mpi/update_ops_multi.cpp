@@ -0,0 +1,124 @@
+#ifdef _USE_MPI
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../default/update_ops.hpp"
+#include "../general/number_util.hpp"
+#include "../general/type.hpp"
+#include "slab_util.hpp"
+#include "update_ops.hpp"
+
+namespace mpi {
+/**
+ * Swap inner qubit <code>inner_qubit_index</code> and outer qubit
+ * <code>outer_qubit_index</code> by exchanging half of the slab.
+ */
+static void swap_inner_outer(UINT inner_qubit_index, UINT outer_qubit_index,
+    CTYPE* state, ITYPE dim) {
+    const int pair_rank = get_pair_rank(outer_qubit_index, dim);
+    // the amplitudes whose inner qubit differs from the outer qubit of this
+    // rank are sent, and the pair sends the same positions back
+    const ITYPE mask =
+        (ITYPE)(1 - get_outer_bit(outer_qubit_index, dim)) << inner_qubit_index;
+    MPIutil::get_inst().m_DC_sendrecv_pipeline(
+        dim / 2, pair_rank,
+        [&](ITYPE begin, ITYPE chunk_dim, CTYPE* buffer) {
+            for (ITYPE i = 0; i < chunk_dim; ++i) {
+                buffer[i] = state[insert_zero_to_basis_index(
+                                      begin + i, inner_qubit_index) |
+                                  mask];
+            }
+            return buffer;
+        },
+        [&](ITYPE begin, ITYPE chunk_dim, const CTYPE* received) {
+            for (ITYPE i = 0; i < chunk_dim; ++i) {
+                state[insert_zero_to_basis_index(
+                          begin + i, inner_qubit_index) |
+                      mask] = received[i];
+            }
+        });
+}
+
+void SWAP_gate(UINT target_qubit_index_0, UINT target_qubit_index_1,
+    CTYPE* state, ITYPE dim) {
+    if (target_qubit_index_0 == target_qubit_index_1) return;
+    const UINT inner_qc = get_inner_qubit_count(dim);
+    const UINT min_qubit_index =
+        std::min(target_qubit_index_0, target_qubit_index_1);
+    const UINT max_qubit_index =
+        std::max(target_qubit_index_0, target_qubit_index_1);
+    if (max_qubit_index < inner_qc) {
+        normal::SWAP_gate(min_qubit_index, max_qubit_index, state, dim);
+    } else if (min_qubit_index < inner_qc) {
+        swap_inner_outer(min_qubit_index, max_qubit_index, state, dim);
+    } else if (get_outer_bit(min_qubit_index, dim) !=
+               get_outer_bit(max_qubit_index, dim)) {
+        const int pair_rank = MPIutil::get_inst().get_rank() ^
+                              (1 << (min_qubit_index - inner_qc)) ^
+                              (1 << (max_qubit_index - inner_qc));
+        exchange_slab(state, dim, pair_rank,
+            [](CTYPE* chunk, const CTYPE* received, ITYPE chunk_dim) {
+                std::copy(received, received + chunk_dim, chunk);
+            });
+    }
+}
+
+void multi_qubit_control_multi_qubit_dense_matrix_gate(
+    const std::vector<UINT>& control_qubit_index_list,
+    const std::vector<UINT>& control_value_list,
+    const std::vector<UINT>& target_qubit_index_list,
+    const std::vector<CTYPE>& matrix, CTYPE* state, ITYPE dim) {
+    const UINT inner_qc = get_inner_qubit_count(dim);
+    std::vector<bool> is_used(inner_qc, false);
+    for (UINT qubit_index : control_qubit_index_list) {
+        if (qubit_index < inner_qc) is_used[qubit_index] = true;
+    }
+    for (UINT qubit_index : target_qubit_index_list) {
+        if (qubit_index < inner_qc) is_used[qubit_index] = true;
+    }
+
+    // pair each outer target with the highest unused inner qubit. this
+    // only depends on the arguments, so all ranks agree or throw together
+    std::vector<UINT> local_target_list = target_qubit_index_list;
+    std::vector<std::pair<UINT, UINT>> swap_list;
+    UINT candidate = inner_qc;
+    for (UINT& target_qubit_index : local_target_list) {
+        if (target_qubit_index < inner_qc) continue;
+        do {
+            if (candidate == 0) {
+                throw std::invalid_argument(
+                    "not enough inner qubits to apply the gate.");
+            }
+            --candidate;
+        } while (is_used[candidate]);
+        swap_list.emplace_back(candidate, target_qubit_index);
+        target_qubit_index = candidate;
+    }
+
+    // the pairs of the swaps differ only in targets, so they skip together
+    std::vector<UINT> local_control_list, local_value_list;
+    for (UINT i = 0; i < control_qubit_index_list.size(); ++i) {
+        const UINT control_qubit_index = control_qubit_index_list[i];
+        if (control_qubit_index < inner_qc) {
+            local_control_list.push_back(control_qubit_index);
+            local_value_list.push_back(control_value_list[i]);
+        } else if (get_outer_bit(control_qubit_index, dim) !=
+                   control_value_list[i]) {
+            return;
+        }
+    }
+
+    for (const auto& [inner_qubit_index, outer_qubit_index] : swap_list) {
+        swap_inner_outer(inner_qubit_index, outer_qubit_index, state, dim);
+    }
+    normal::multi_qubit_control_multi_qubit_dense_matrix_gate(
+        local_control_list, local_value_list, local_target_list, matrix,
+        state, dim);
+    for (auto ite = swap_list.rbegin(); ite != swap_list.rend(); ++ite) {
+        swap_inner_outer(ite->first, ite->second, state, dim);
+    }
+}
+}  // namespace mpi
+#endif  // #ifdef _USE_MPI
@@ -0,0 +1,194 @@
+#ifdef _USE_MPI
+#include <algorithm>
+#include <cmath>
+
+#ifdef _OPENMP
+#include "../general/omp_util.hpp"
+#endif
+
+#include "../default/state_ops.hpp"
+#include "../default/update_ops.hpp"
+#include "../general/type.hpp"
+#include "slab_util.hpp"
+#include "update_ops.hpp"
+
+namespace mpi {
+/**
+ * Multiply every amplitude of the slab by <code>coef</code>.
+ */
+static void scale_slab(CTYPE coef, CTYPE* state, ITYPE dim) {
+    if (coef == 1.) return;
+    const double coef_real = coef.real();
+    const double coef_imag = coef.imag();
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE state_index = 0; state_index < dim; ++state_index) {
+        const double real = state[state_index].real();
+        const double imag = state[state_index].imag();
+        state[state_index] = CTYPE(coef_real * real - coef_imag * imag,
+            coef_real * imag + coef_imag * real);
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+static void clear_slab(CTYPE* state, ITYPE dim) {
+#ifdef _OPENMP
+    OMPutil::get_inst().set_qulacs_num_threads(dim, 13);
+#pragma omp parallel for
+#endif
+    for (ITYPE state_index = 0; state_index < dim; ++state_index) {
+        state[state_index] = 0.;
+    }
+#ifdef _OPENMP
+    OMPutil::get_inst().reset_qulacs_num_threads();
+#endif
+}
+
+void project_and_normalize(
+    ITYPE mask, ITYPE value, double norm, CTYPE* state, ITYPE dim) {
+    const ITYPE inner_mask = dim - 1;
+    const ITYPE rank = MPIutil::get_inst().get_rank();
+    const ITYPE outer_value = rank << get_inner_qubit_count(dim);
+    if ((outer_value & mask) != (value & ~inner_mask)) {
+        clear_slab(state, dim);
+        return;
+    }
+    normal::project_and_normalize(
+        mask & inner_mask, value & inner_mask, norm, state, dim);
+}
+
+void single_qubit_dense_matrix_gate(UINT target_qubit_index,
+    const CTYPE matrix[4], CTYPE* state, ITYPE dim) {
+    if (target_qubit_index < get_inner_qubit_count(dim)) {
+        normal::single_qubit_dense_matrix_gate(
+            target_qubit_index, matrix, state, dim);
+        return;
+    }
+    // new amplitude is matrix[b][b] * local + matrix[b][1-b] * pair
+    const UINT bit = get_outer_bit(target_qubit_index, dim);
+    const CTYPE diagonal = matrix[bit * 2 + bit];
+    const CTYPE off_diagonal = matrix[bit * 2 + (1 - bit)];
+    exchange_slab(state, dim, get_pair_rank(target_qubit_index, dim),
+        [&](CTYPE* chunk, const CTYPE* received, ITYPE chunk_dim) {
+            normal::add_with_coef(
+                diagonal, chunk, off_diagonal, received, chunk, chunk_dim);
+        });
+}
+
+void single_qubit_diagonal_matrix_gate(UINT target_qubit_index,
+    const CTYPE diagonal_matrix[2], CTYPE* state, ITYPE dim) {
+    if (target_qubit_index < get_inner_qubit_count(dim)) {
+        normal::single_qubit_diagonal_matrix_gate(
+            target_qubit_index, diagonal_matrix, state, dim);
+        return;
+    }
+    scale_slab(
+        diagonal_matrix[get_outer_bit(target_qubit_index, dim)], state, dim);
+}
+
+void single_qubit_phase_gate(
+    UINT target_qubit_index, CTYPE phase, CTYPE* state, ITYPE dim) {
+    if (target_qubit_index < get_inner_qubit_count(dim)) {
+        normal::single_qubit_phase_gate(target_qubit_index, phase, state, dim);
+        return;
+    }
+    if (get_outer_bit(target_qubit_index, dim)) scale_slab(phase, state, dim);
+}
+
+void X_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim) {
+    if (target_qubit_index < get_inner_qubit_count(dim)) {
+        normal::X_gate(target_qubit_index, state, dim);
+        return;
+    }
+    exchange_slab(state, dim, get_pair_rank(target_qubit_index, dim),
+        [](CTYPE* chunk, const CTYPE* received, ITYPE chunk_dim) {
+            std::copy(received, received + chunk_dim, chunk);
+        });
+}
+
+void Y_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim) {
+    if (target_qubit_index < get_inner_qubit_count(dim)) {
+        normal::Y_gate(target_qubit_index, state, dim);
+        return;
+    }
+    // new_0 = -i * old_1, new_1 = i * old_0
+    const double sign = get_outer_bit(target_qubit_index, dim) ? 1. : -1.;
+    exchange_slab(state, dim, get_pair_rank(target_qubit_index, dim),
+        [&](CTYPE* chunk, const CTYPE* received, ITYPE chunk_dim) {
+            for (ITYPE i = 0; i < chunk_dim; ++i) {
+                chunk[i] = CTYPE(
+                    -sign * received[i].imag(), sign * received[i].real());
+            }
+        });
+}
+
+void Z_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim) {
+    if (target_qubit_index < get_inner_qubit_count(dim)) {
+        normal::Z_gate(target_qubit_index, state, dim);
+        return;
+    }
+    single_qubit_phase_gate(target_qubit_index, -1., state, dim);
+}
+
+void S_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim) {
+    if (target_qubit_index < get_inner_qubit_count(dim)) {
+        normal::S_gate(target_qubit_index, state, dim);
+        return;
+    }
+    single_qubit_phase_gate(target_qubit_index, 1.i, state, dim);
+}
+
+void Sdag_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim) {
+    if (target_qubit_index < get_inner_qubit_count(dim)) {
+        normal::Sdag_gate(target_qubit_index, state, dim);
+        return;
+    }
+    single_qubit_phase_gate(target_qubit_index, -1.i, state, dim);
+}
+
+void T_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim) {
+    if (target_qubit_index < get_inner_qubit_count(dim)) {
+        normal::T_gate(target_qubit_index, state, dim);
+        return;
+    }
+    single_qubit_phase_gate(target_qubit_index,
+        CTYPE(1. / sqrt(2.), 1. / sqrt(2.)), state, dim);
+}
+
+void Tdag_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim) {
+    if (target_qubit_index < get_inner_qubit_count(dim)) {
+        normal::Tdag_gate(target_qubit_index, state, dim);
+        return;
+    }
+    single_qubit_phase_gate(target_qubit_index,
+        CTYPE(1. / sqrt(2.), -1. / sqrt(2.)), state, dim);
+}
+
+void P0_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim) {
+    if (target_qubit_index < get_inner_qubit_count(dim)) {
+        normal::P0_gate(target_qubit_index, state, dim);
+        return;
+    }
+    if (get_outer_bit(target_qubit_index, dim) == 1) clear_slab(state, dim);
+}
+
+void P1_gate(UINT target_qubit_index, CTYPE* state, ITYPE dim) {
+    if (target_qubit_index < get_inner_qubit_count(dim)) {
+        normal::P1_gate(target_qubit_index, state, dim);
+        return;
+    }
+    if (get_outer_bit(target_qubit_index, dim) == 0) clear_slab(state, dim);
+}
+
+void RZ_gate(UINT target_qubit_index, double angle, CTYPE* state, ITYPE dim) {
+    const CTYPE diagonal_matrix[2] = {CTYPE(cos(angle / 2), -sin(angle / 2)),
+        CTYPE(cos(angle / 2), sin(angle / 2))};
+    single_qubit_diagonal_matrix_gate(
+        target_qubit_index, diagonal_matrix, state, dim);
+}
+}  // namespace mpi
+#endif  // #ifdef _USE_MPI
@@ -0,0 +1,94 @@
+#include "observable.hpp"
+
+#include <cassert>
+#include <sstream>
+#include <stdexcept>
+
+#include "internal/default/stat_ops.hpp"
+#include "internal/general/check_constraints.hpp"
+
+constexpr StateVectorImplementation DEFAULT =
+    StateVectorImplementation::DEFAULT;
+constexpr StateVectorImplementation DEFAULT_F32 =
+    StateVectorImplementation::DEFAULT_F32;
+
+Observable::Observable(UINT qubit_count_)
+    : _qubit_count(qubit_count_), _term_count(0) {}
+
+void Observable::add_term(CTYPE coef,
+    const std::vector<UINT>& target_qubit_index_list,
+    const std::vector<UINT>& pauli_id_list) {
+    check_equal("pauli_id_list", (UINT)pauli_id_list.size(),
+        (UINT)target_qubit_index_list.size());
+    for (UINT target_qubit_index : target_qubit_index_list) {
+        check_out_of_range(
+            "target_qubit_index", target_qubit_index, 0U, this->_qubit_count);
+    }
+    check_no_duplicate("target_qubit_index_list", target_qubit_index_list);
+    ITYPE x_mask = 0, z_mask = 0;
+    for (UINT i = 0; i < pauli_id_list.size(); ++i) {
+        check_out_of_range("pauli_id", pauli_id_list[i], 0U, 4U);
+        const ITYPE bit = 1ULL << target_qubit_index_list[i];
+        if (pauli_id_list[i] == 1 || pauli_id_list[i] == 2) x_mask |= bit;
+        if (pauli_id_list[i] == 2 || pauli_id_list[i] == 3) z_mask |= bit;
+    }
+
+    auto it = this->_group_index.find(x_mask);
+    if (it == this->_group_index.end()) {
+        it = this->_group_index.emplace(x_mask, this->_group_list.size())
+                 .first;
+        this->_group_list.push_back(PauliGroup{x_mask, {}, {}});
+    }
+    PauliGroup& group = this->_group_list[it->second];
+    group.z_mask_list.push_back(z_mask);
+    group.coef_list.push_back(coef);
+    ++this->_term_count;
+}
+
+void Observable::add_term(CTYPE coef, const std::string& pauli_string) {
+    std::vector<UINT> target_qubit_index_list, pauli_id_list;
+    std::istringstream stream(pauli_string);
+    std::string pauli;
+    while (stream >> pauli) {
+        UINT target_qubit_index;
+        if (!(stream >> target_qubit_index)) {
+            throw std::invalid_argument(
+                "pauli_string must be pairs of Pauli and qubit index: " +
+                pauli_string);
+        }
+        if (pauli == "I" || pauli == "i") {
+            continue;
+        } else if (pauli == "X" || pauli == "x") {
+            pauli_id_list.push_back(1);
+        } else if (pauli == "Y" || pauli == "y") {
+            pauli_id_list.push_back(2);
+        } else if (pauli == "Z" || pauli == "z") {
+            pauli_id_list.push_back(3);
+        } else {
+            throw std::invalid_argument("unknown Pauli: " + pauli);
+        }
+        target_qubit_index_list.push_back(target_qubit_index);
+    }
+    this->add_term(coef, target_qubit_index_list, pauli_id_list);
+}
+
+template <StateVectorImplementation IMPL>
+CTYPE Observable::get_expectation_value(const StateVector<IMPL>& state) const {
+    check_equal("state.qubit_count", state.qubit_count, this->_qubit_count);
+    CTYPE sum = 0.;
+    for (const PauliGroup& group : this->_group_list) {
+        if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+            sum += normal::expectation_value_pauli_group(
+                state.get_amplitudes().data(), state.dim, group.x_mask,
+                group.z_mask_list, group.coef_list);
+        } else {
+            assert(false);  // unknown IMPL. must be unreachable
+        }
+    }
+    return sum;
+}
+
+template CTYPE Observable::get_expectation_value(
+    const StateVector<DEFAULT>& state) const;
+template CTYPE Observable::get_expectation_value(
+    const StateVector<DEFAULT_F32>& state) const;
@@ -0,0 +1,92 @@
+/**
+ * @file observable.hpp
+ * @brief Observable class definition
+ */
+
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "internal/general/type.hpp"
+#include "state_vector.hpp"
+
+/**
+ * @brief weighted sum of Pauli strings
+ * \~japanese-en Pauli演算子の積の重み付き和で表されるオブザーバブル
+ *
+ * 各Pauli演算子の積はXを持つ量子ビットのマスクとZを持つ量子ビットのマスクで保持し、
+ * Yは両方に含まれる量子ビットとして表す。期待値は行列を作らず、状態のコピーも作らずに計算する。
+ * Xのマスクが等しい項はまとめて保持し、一度の状態の走査で期待値を計算する。
+ */
+class Observable {
+private:
+    struct PauliGroup {
+        ITYPE x_mask;
+        std::vector<ITYPE> z_mask_list;
+        std::vector<CTYPE> coef_list;
+    };
+
+    UINT _qubit_count;
+    UINT _term_count;
+    std::vector<PauliGroup> _group_list;
+    std::unordered_map<ITYPE, UINT> _group_index;
+
+public:
+    /**
+     * @brief constructor
+     * \~japanese-en コンストラクタ
+     * @param qubit_count num of qubits
+     */
+    Observable(UINT qubit_count_);
+
+    /**
+     * @brief num of qubits
+     * \~japanese-en 量子ビット数
+     */
+    UINT get_qubit_count() const { return _qubit_count; }
+
+    /**
+     * @brief num of Pauli strings
+     * \~japanese-en 項の数
+     */
+    UINT get_term_count() const { return _term_count; }
+
+    /**
+     * @brief num of groups of terms sharing X mask
+     * \~japanese-en Xのマスクが等しい項のグループの数。期待値計算で状態を走査する回数に等しい
+     */
+    UINT get_group_count() const { return _group_list.size(); }
+
+    /**
+     * @brief add Pauli string
+     * \~japanese-en Pauli演算子の積を項として追加する
+     *
+     * @param coef 係数
+     * @param target_qubit_index_list 作用する量子ビットのインデックスのリスト
+     * @param pauli_id_list Pauli演算子のリスト。0,1,2,3がそれぞれI,X,Y,Zを表す
+     */
+    void add_term(CTYPE coef, const std::vector<UINT>& target_qubit_index_list,
+        const std::vector<UINT>& pauli_id_list);
+
+    /**
+     * @brief add Pauli string written as text
+     * \~japanese-en 文字列で表したPauli演算子の積を項として追加する
+     *
+     * @param coef 係数
+     * @param pauli_string "X 0 Y 3 Z 5"のように、Pauli演算子と量子ビットのインデックスを
+     * 空白区切りで並べた文字列。空文字列は恒等演算子を表す
+     */
+    void add_term(CTYPE coef, const std::string& pauli_string);
+
+    /**
+     * @brief calculate expectation value
+     * \~japanese-en 量子状態に対する期待値を計算する
+     *
+     * 量子状態は変更しない。
+     * @param state 期待値を計算する量子状態
+     * @return 期待値
+     */
+    template <StateVectorImplementation IMPL>
+    CTYPE get_expectation_value(const StateVector<IMPL>& state) const;
+};
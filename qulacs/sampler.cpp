@@ -0,0 +1,24 @@
+#include "sampler.hpp"
+
+#include "internal/default/stat_ops.hpp"
+
+constexpr StateVectorImplementation DEFAULT =
+    StateVectorImplementation::DEFAULT;
+constexpr StateVectorImplementation DEFAULT_F32 =
+    StateVectorImplementation::DEFAULT_F32;
+
+template <StateVectorImplementation IMPL>
+Sampler::Sampler(const StateVector<IMPL>& state)
+    : _cumulative_probability(state.dim) {
+    normal::cumulative_probability(state.get_amplitudes().data(), state.dim,
+        _cumulative_probability.data());
+}
+
+std::vector<ITYPE> Sampler::sampling(UINT sampling_count, UINT seed) const {
+    return normal::sampling_from_cumulative_probability(
+        _cumulative_probability.data(), _cumulative_probability.size(),
+        sampling_count, seed);
+}
+
+template Sampler::Sampler(const StateVector<DEFAULT>& state);
+template Sampler::Sampler(const StateVector<DEFAULT_F32>& state);
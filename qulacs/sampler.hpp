@@ -0,0 +1,45 @@
+/**
+ * @file sampler.hpp
+ * @brief Sampler class definition
+ */
+
+#pragma once
+#include <ctime>
+#include <vector>
+
+#include "internal/general/type.hpp"
+#include "state_vector.hpp"
+
+/**
+ * @brief sampler of computational basis which reuses the cumulative
+ * distribution of a state
+ * \~japanese-en 量子状態の累積分布を再利用して計算基底をサンプリングする
+ *
+ * 構築時に累積分布を並列に計算して保持する。同じ状態から繰り返しサンプリングする場合、
+ * StateVector::samplingより状態の走査が少なくて済む。
+ * 構築後に元の状態を変更しても結果には反映されない。
+ */
+class Sampler {
+private:
+    std::vector<double> _cumulative_probability;
+
+public:
+    /**
+     * @brief constructor
+     * \~japanese-en コンストラクタ
+     * @param state サンプリング元の量子状態
+     */
+    template <StateVectorImplementation IMPL>
+    explicit Sampler(const StateVector<IMPL>& state);
+
+    /**
+     * @brief do sampling of measured computational basis
+     * \~japanese-en 量子状態を測定した際の計算基底のサンプリングを行う
+     *
+     * @param[in] sampling_count サンプリングを行う回数
+     * @param[in] seed サンプリングで乱数を振るシード値
+     * @return サンプルされた値のリスト
+     */
+    std::vector<ITYPE> sampling(
+        UINT sampling_count, UINT seed = (UINT)time(nullptr)) const;
+};
@@ -1,58 +1,141 @@
 #include "state_vector.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <numeric>
+#include <stdexcept>
 
 #include "internal/default/init_ops.hpp"
 #include "internal/default/stat_ops.hpp"
+#include "internal/default/state_ops.hpp"
 #include "internal/default/update_ops.hpp"
 #include "internal/general/check_constraints.hpp"
 #include "internal/general/random.hpp"
+#include "internal/mpi/init_ops.hpp"
+#include "internal/mpi/stat_ops.hpp"
+#include "internal/mpi/state_ops.hpp"
+#include "internal/mpi/update_ops.hpp"
 
+#ifdef _OPENMP
+#include "internal/general/omp_util.hpp"
+#endif
 #ifdef _USE_MPI
 #include "internal/mpi/mpi_util.hpp"
 #endif
 
 constexpr StateVectorImplementation DEFAULT =
     StateVectorImplementation::DEFAULT;
+constexpr StateVectorImplementation DEFAULT_F32 =
+    StateVectorImplementation::DEFAULT_F32;
 constexpr StateVectorImplementation MPI = StateVectorImplementation::MPI;
 
-template <>
-struct StateVectorData<DEFAULT> {
-    std::vector<CTYPE> data;
+#ifdef _USE_MPI
+/**
+ * Number of qubits distributed over the active ranks.
+ */
+static UINT get_outer_qubit_count(UINT qubit_count) {
+    MPIutil& mpiutil = MPIutil::get_inst();
+    if (!mpiutil.is_active()) {
+        throw std::runtime_error(
+            "this rank does not hold StateVector<MPI>. see get_layout().");
+    }
+    const UINT mpisize = mpiutil.get_size();
+    UINT lognodes = 0;
+    while ((1U << lognodes) < mpisize) ++lognodes;
+    check_out_of_range("qubit_count", qubit_count, lognodes, 64U);
+    return lognodes;
+}
 
-    StateVectorData(UINT qubit_count) : data(1ULL << qubit_count) {}
-};
+StateVectorData<MPI>::StateVectorData(UINT qubit_count)
+    : outer_qc(get_outer_qubit_count(qubit_count)),
+      inner_qc(qubit_count - outer_qc),
+      data(1ULL << inner_qc),
+      qubit_map(qubit_count) {
+    std::iota(qubit_map.begin(), qubit_map.end(), 0U);
+}
 
-template <>
-struct StateVectorData<MPI> {
-    std::vector<CTYPE> data;
-    UINT inner_qc;
-    UINT outer_qc;
+/**
+ * Move bit q of <code>basis</code> to bit <code>qubit_map[q]</code>.
+ */
+static ITYPE to_physical_basis(
+    ITYPE basis, const std::vector<UINT>& qubit_map) {
+    ITYPE physical_basis = 0;
+    for (UINT qubit_index = 0; qubit_index < qubit_map.size(); ++qubit_index) {
+        physical_basis |= ((basis >> qubit_index) & 1)
+                          << qubit_map[qubit_index];
+    }
+    return physical_basis;
+}
 
-    StateVectorData(UINT qubit_count) {
-#ifdef _USE_MPI
-        MPIutil& mpiutil = MPIutil::getinst();
-        UINT mpirank = mpiutil.get_rank();
-        UINT mpisize = mpiutil.get_size();
-        UINT lognodes = (UINT)std::log2(mpisize);
-        inner_qc = qubit_count - lognodes;
-        outer_qc = lognodes;
-#else
-        assert(false);  // MPI is not available
-#endif
+/**
+ * Move bit <code>qubit_map[q]</code> of <code>basis</code> to bit q.
+ */
+static ITYPE to_logical_basis(ITYPE basis, const std::vector<UINT>& qubit_map) {
+    ITYPE logical_basis = 0;
+    for (UINT qubit_index = 0; qubit_index < qubit_map.size(); ++qubit_index) {
+        logical_basis |= ((basis >> qubit_map[qubit_index]) & 1)
+                         << qubit_index;
     }
-};
+    return logical_basis;
+}
+
+static std::vector<UINT> to_physical_qubits(
+    const std::vector<UINT>& qubit_index_list,
+    const std::vector<UINT>& qubit_map) {
+    std::vector<UINT> physical_qubit_list;
+    for (UINT qubit_index : qubit_index_list) {
+        physical_qubit_list.push_back(qubit_map[qubit_index]);
+    }
+    return physical_qubit_list;
+}
+#endif  // #ifdef _USE_MPI
 
 template <StateVectorImplementation IMPL>
-StateVector<IMPL>::StateVector(UINT qubit_count_)
+StateVector<IMPL>::StateVector(UINT qubit_count_, bool initialize)
     : _qubit_count(qubit_count_),
       _dim(1ULL << qubit_count_),
-      _data(qubit_count_) {}
+      _data(qubit_count_) {
+    if (initialize) set_zero_norm_state();
+}
+
+template <StateVectorImplementation IMPL>
+StateVector<IMPL>::StateVector(StateVector&& other)
+    : _qubit_count(other._qubit_count),
+      _dim(other._dim),
+      _data(std::move(other._data)) {}
+
+template <StateVectorImplementation IMPL>
+StateVectorLayout StateVector<IMPL>::get_layout() {
+    StateVectorLayout layout;
+#ifdef _OPENMP
+    layout.thread_count = OMPutil::get_inst().get_qulacs_num_thread_max();
+#endif
+    if constexpr (IMPL == MPI) {
+#ifdef _USE_MPI
+        MPIutil& mpiutil = MPIutil::get_inst();
+        layout.world_size = mpiutil.get_world_size();
+        layout.world_rank = mpiutil.get_world_rank();
+        layout.active_size = mpiutil.get_size();
+        layout.active = mpiutil.is_active();
+        layout.active_rank = layout.active ? mpiutil.get_rank() : 0;
+        layout.node_count = mpiutil.get_node_count();
+        layout.node_index = mpiutil.get_node_index();
+        layout.node_size = mpiutil.get_node_size();
+        layout.node_active_size = mpiutil.get_node_active_size();
+#endif
+    }
+    return layout;
+}
 
 template <StateVectorImplementation IMPL>
 void StateVector<IMPL>::set_zero_state() {
-    if constexpr (IMPL == DEFAULT) {
-        normal::initialize_quantum_state(this->_data.data);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::initialize_quantum_state(this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        mpi::initialize_quantum_state(this->_data.data.data(),
+            this->_data.data.size());
+        std::iota(this->_data.qubit_map.begin(), this->_data.qubit_map.end(),
+            0U);
     } else {
         assert(false);  // unknown IMPL. must be unreachable
     }
@@ -61,7 +144,7 @@ void StateVector<IMPL>::set_zero_state() {
 template <StateVectorImplementation IMPL>
 void StateVector<IMPL>::set_zero_norm_state() {
     set_zero_state();
-    if constexpr (IMPL == DEFAULT) {
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32 || IMPL == MPI) {
         this->_data.data[0] = 0.0;
     } else {
         assert(false);  // unknown IMPL. must be unreachable
@@ -71,10 +154,15 @@ void StateVector<IMPL>::set_zero_norm_state() {
 template <StateVectorImplementation IMPL>
 void StateVector<IMPL>::set_computational_basis(ITYPE comp_basis) {
     check_out_of_range("comp_basis", comp_basis, 0ULL, this->_dim);
-    set_zero_state();
-    if constexpr (IMPL == DEFAULT) {
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        set_zero_state();
         this->_data.data[0] = 0.0;
         this->_data.data[comp_basis] = 1.0;
+    } else if constexpr (IMPL == MPI) {
+        mpi::initialize_computational_basis(comp_basis, this->_data.data.data(),
+            this->_data.data.size());
+        std::iota(this->_data.qubit_map.begin(), this->_data.qubit_map.end(),
+            0U);
     } else {
         assert(false);  // unknown IMPL. must be unreachable
     }
@@ -82,8 +170,14 @@ void StateVector<IMPL>::set_computational_basis(ITYPE comp_basis) {
 
 template <StateVectorImplementation IMPL>
 void StateVector<IMPL>::set_Haar_random_state(UINT seed) {
-    if constexpr (IMPL == DEFAULT) {
-        normal::initialize_Haar_random_state(this->_data.data, seed);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::initialize_Haar_random_state(
+            this->_data.data.data(), this->_dim, seed);
+    } else if constexpr (IMPL == MPI) {
+        mpi::initialize_Haar_random_state(this->_data.data.data(),
+            this->_data.data.size(), seed);
+        std::iota(this->_data.qubit_map.begin(), this->_data.qubit_map.end(),
+            0U);
     } else {
         assert(false);  // unknown IMPL. must be unreachable
     }
@@ -93,8 +187,31 @@ template <StateVectorImplementation IMPL>
 double StateVector<IMPL>::get_zero_probability(UINT target_qubit_index) const {
     check_out_of_range(
         "target_qubit_index", target_qubit_index, 0U, this->_qubit_count);
-    if constexpr (IMPL == DEFAULT) {
-        return normal::m0_prob(this->_data.data, target_qubit_index);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        return normal::m0_prob(
+            this->_data.data.data(), this->_dim, target_qubit_index);
+    } else if constexpr (IMPL == MPI) {
+        return mpi::m0_prob(this->_data.data.data(), this->_data.data.size(),
+            this->_data.qubit_map[target_qubit_index]);
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+std::vector<double> StateVector<IMPL>::get_zero_probabilities() const {
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        return normal::zero_probabilities(this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        const std::vector<double> physical_list =
+            mpi::zero_probabilities(this->_data.data.data(),
+                this->_data.data.size(), this->_qubit_count);
+        std::vector<double> zero_probability_list(this->_qubit_count);
+        for (UINT i = 0; i < this->_qubit_count; ++i) {
+            zero_probability_list[i] =
+                physical_list[this->_data.qubit_map[i]];
+        }
+        return zero_probability_list;
     } else {
         assert(false);  // unknown IMPL. must be unreachable
     }
@@ -114,9 +231,34 @@ double StateVector<IMPL>::get_marginal_probability(
             target_value.push_back(measured_value);
         }
     }
-    if constexpr (IMPL == DEFAULT) {
-        return normal::marginal_prob(
-            this->_data.data, target_index, target_value);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        return normal::marginal_prob(this->_data.data.data(), this->_dim,
+            target_index, target_value);
+    } else if constexpr (IMPL == MPI) {
+        return mpi::marginal_prob(this->_data.data.data(),
+            this->_data.data.size(),
+            to_physical_qubits(target_index, this->_data.qubit_map),
+            target_value);
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+std::vector<double> StateVector<IMPL>::get_marginal_distribution(
+    const std::vector<UINT>& target_qubit_index_list) const {
+    for (UINT target_qubit_index : target_qubit_index_list) {
+        check_out_of_range(
+            "target_qubit_index", target_qubit_index, 0U, this->_qubit_count);
+    }
+    check_no_duplicate("target_qubit_index_list", target_qubit_index_list);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        return normal::marginal_distribution(
+            this->_data.data.data(), this->_dim, target_qubit_index_list);
+    } else if constexpr (IMPL == MPI) {
+        return mpi::marginal_distribution(this->_data.data.data(),
+            this->_data.data.size(),
+            to_physical_qubits(target_qubit_index_list, this->_data.qubit_map));
     } else {
         assert(false);  // unknown IMPL. must be unreachable
     }
@@ -124,17 +266,72 @@ double StateVector<IMPL>::get_marginal_probability(
 
 template <StateVectorImplementation IMPL>
 double StateVector<IMPL>::get_entropy() const {
-    if constexpr (IMPL == DEFAULT) {
-        return normal::measurement_distribution_entropy(this->_data.data);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        return normal::measurement_distribution_entropy(
+            this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        return mpi::measurement_distribution_entropy(this->_data.data.data(),
+            this->_data.data.size());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+Statistics StateVector<IMPL>::get_statistics(
+    const StatisticsRequest& request) const {
+    std::vector<ITYPE> marginal_mask_list, marginal_value_list;
+    for (const std::vector<UINT>& measured_values : request.marginal_list) {
+        check_equal("measured_values", (UINT)measured_values.size(),
+            this->_qubit_count);
+        ITYPE mask = 0, value = 0;
+        for (UINT i = 0; i < measured_values.size(); ++i) {
+            if (measured_values[i] == 0 || measured_values[i] == 1) {
+                mask |= 1ULL << i;
+                value |= (ITYPE)measured_values[i] << i;
+            }
+        }
+        marginal_mask_list.push_back(mask);
+        marginal_value_list.push_back(value);
+    }
+    Statistics statistics;
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::fused_statistics(this->_data.data.data(), this->_dim,
+            request.entropy, request.zero_probabilities, marginal_mask_list,
+            marginal_value_list, statistics.squared_norm, statistics.entropy,
+            statistics.zero_probabilities, statistics.marginal_probabilities);
+    } else if constexpr (IMPL == MPI) {
+        const std::vector<UINT>& qubit_map = this->_data.qubit_map;
+        for (UINT m = 0; m < marginal_mask_list.size(); ++m) {
+            marginal_mask_list[m] = to_physical_basis(
+                marginal_mask_list[m], this->_data.qubit_map);
+            marginal_value_list[m] = to_physical_basis(
+                marginal_value_list[m], this->_data.qubit_map);
+        }
+        std::vector<double> zero_probability_list;
+        mpi::fused_statistics(this->_data.data.data(), this->_data.data.size(),
+            this->_qubit_count, request.entropy, request.zero_probabilities,
+            marginal_mask_list, marginal_value_list, statistics.squared_norm,
+            statistics.entropy, zero_probability_list,
+            statistics.marginal_probabilities);
+        for (UINT i = 0; i < zero_probability_list.size(); ++i) {
+            statistics.zero_probabilities.push_back(
+                zero_probability_list[qubit_map[i]]);
+        }
     } else {
         assert(false);  // unknown IMPL. must be unreachable
     }
+    return statistics;
 }
 
 template <StateVectorImplementation IMPL>
 double StateVector<IMPL>::get_squared_norm() const {
-    if constexpr (IMPL == DEFAULT) {
-        return normal::state_norm_squared(this->_data.data);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        return normal::state_norm_squared(
+            this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        return mpi::state_norm_squared(this->_data.data.data(),
+            this->_data.data.size());
     } else {
         assert(false);  // unknown IMPL. must be unreachable
     }
@@ -142,8 +339,367 @@ double StateVector<IMPL>::get_squared_norm() const {
 
 template <StateVectorImplementation IMPL>
 void StateVector<IMPL>::normalize(double squared_norm) {
-    if constexpr (IMPL == DEFAULT) {
-        normal::normalize(this->_data.data, squared_norm);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::normalize(
+            this->_data.data.data(), this->_dim, squared_norm);
+    } else if constexpr (IMPL == MPI) {
+        normal::normalize(
+            this->_data.data.data(), this->_data.data.size(), squared_norm);
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+double StateVector<IMPL>::apply_projection(
+    const std::vector<UINT>& target_qubit_index_list,
+    const std::vector<UINT>& projection_list) {
+    check_equal("projection_list.size()", (UINT)projection_list.size(),
+        (UINT)target_qubit_index_list.size());
+    for (UINT target_qubit_index : target_qubit_index_list) {
+        check_out_of_range(
+            "target_qubit_index", target_qubit_index, 0U, this->_qubit_count);
+    }
+    check_no_duplicate("target_qubit_index_list", target_qubit_index_list);
+    std::vector<UINT> measured_values(this->_qubit_count, 2);
+    ITYPE mask = 0, value = 0;
+    for (UINT i = 0; i < target_qubit_index_list.size(); ++i) {
+        check_out_of_range("projection", projection_list[i], 0U, 2U);
+        measured_values[target_qubit_index_list[i]] = projection_list[i];
+        mask |= 1ULL << target_qubit_index_list[i];
+        value |= (ITYPE)projection_list[i] << target_qubit_index_list[i];
+    }
+    const double probability = get_marginal_probability(measured_values);
+    project_and_normalize(mask, value, probability);
+    return probability;
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::project_and_normalize(
+    ITYPE mask, ITYPE value, double probability) {
+    if (probability <= 0.) {
+        throw std::invalid_argument("projection has zero probability.");
+    }
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::project_and_normalize(
+            mask, value, probability, this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        mpi::project_and_normalize(
+            to_physical_basis(mask, this->_data.qubit_map),
+            to_physical_basis(value, this->_data.qubit_map), probability,
+            this->_data.data.data(), this->_data.data.size());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+UINT StateVector<IMPL>::measure(UINT target_qubit_index, UINT seed) {
+    const double zero_probability = get_zero_probability(target_qubit_index);
+    if constexpr (IMPL == MPI) {
+        // every rank has to project onto the same outcome
+        seed = mpi::broadcast_seed(seed);
+    }
+    Random random(seed);
+    const UINT result = random.uniform() < zero_probability ? 0 : 1;
+    // the probability of the outcome is already known, so only the
+    // projection sweeps the state again
+    const ITYPE mask = 1ULL << target_qubit_index;
+    project_and_normalize(mask, result ? mask : 0,
+        result ? 1. - zero_probability : zero_probability);
+    return result;
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::apply_single_qubit_dense_matrix(
+    UINT target_qubit_index, const CTYPE matrix[4]) {
+    check_out_of_range(
+        "target_qubit_index", target_qubit_index, 0U, this->_qubit_count);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::single_qubit_dense_matrix_gate(
+            target_qubit_index, matrix, this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        mpi::single_qubit_dense_matrix_gate(
+            this->_data.qubit_map[target_qubit_index], matrix,
+            this->_data.data.data(), this->_data.data.size());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::apply_multi_qubit_dense_matrix(
+    const std::vector<UINT>& target_qubit_index_list,
+    const std::vector<CTYPE>& matrix,
+    const std::vector<UINT>& control_qubit_index_list,
+    const std::vector<UINT>& control_value_list) {
+    std::vector<UINT> qubit_index_list = target_qubit_index_list;
+    qubit_index_list.insert(qubit_index_list.end(),
+        control_qubit_index_list.begin(), control_qubit_index_list.end());
+    for (UINT qubit_index : qubit_index_list) {
+        check_out_of_range("qubit_index", qubit_index, 0U, this->_qubit_count);
+    }
+    check_no_duplicate("qubit_index_list", qubit_index_list);
+    check_equal("matrix.size()", (ITYPE)matrix.size(),
+        1ULL << (2 * target_qubit_index_list.size()));
+    check_equal("control_value_list.size()", (UINT)control_value_list.size(),
+        (UINT)control_qubit_index_list.size());
+    for (UINT control_value : control_value_list) {
+        check_out_of_range("control_value", control_value, 0U, 2U);
+    }
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::multi_qubit_control_multi_qubit_dense_matrix_gate(
+            control_qubit_index_list, control_value_list,
+            target_qubit_index_list, matrix, this->_data.data.data(),
+            this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        mpi::multi_qubit_control_multi_qubit_dense_matrix_gate(
+            to_physical_qubits(control_qubit_index_list, this->_data.qubit_map),
+            control_value_list,
+            to_physical_qubits(target_qubit_index_list, this->_data.qubit_map),
+            matrix, this->_data.data.data(), this->_data.data.size());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::apply_single_qubit_diagonal_matrix(
+    UINT target_qubit_index, const CTYPE diagonal_matrix[2]) {
+    check_out_of_range(
+        "target_qubit_index", target_qubit_index, 0U, this->_qubit_count);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::single_qubit_diagonal_matrix_gate(
+            target_qubit_index, diagonal_matrix, this->_data.data.data(),
+            this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        mpi::single_qubit_diagonal_matrix_gate(
+            this->_data.qubit_map[target_qubit_index], diagonal_matrix,
+            this->_data.data.data(), this->_data.data.size());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::apply_single_qubit_phase(
+    UINT target_qubit_index, CTYPE phase) {
+    check_out_of_range(
+        "target_qubit_index", target_qubit_index, 0U, this->_qubit_count);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::single_qubit_phase_gate(
+            target_qubit_index, phase, this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        mpi::single_qubit_phase_gate(this->_data.qubit_map[target_qubit_index],
+            phase, this->_data.data.data(), this->_data.data.size());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::apply_RZ(UINT target_qubit_index, double angle) {
+    check_out_of_range(
+        "target_qubit_index", target_qubit_index, 0U, this->_qubit_count);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::RZ_gate(
+            target_qubit_index, angle, this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        mpi::RZ_gate(this->_data.qubit_map[target_qubit_index], angle,
+            this->_data.data.data(), this->_data.data.size());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::apply_X(UINT target_qubit_index) {
+    check_out_of_range(
+        "target_qubit_index", target_qubit_index, 0U, this->_qubit_count);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::X_gate(
+            target_qubit_index, this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        mpi::X_gate(this->_data.qubit_map[target_qubit_index],
+            this->_data.data.data(), this->_data.data.size());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::apply_Y(UINT target_qubit_index) {
+    check_out_of_range(
+        "target_qubit_index", target_qubit_index, 0U, this->_qubit_count);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::Y_gate(
+            target_qubit_index, this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        mpi::Y_gate(this->_data.qubit_map[target_qubit_index],
+            this->_data.data.data(), this->_data.data.size());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::apply_Z(UINT target_qubit_index) {
+    check_out_of_range(
+        "target_qubit_index", target_qubit_index, 0U, this->_qubit_count);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::Z_gate(
+            target_qubit_index, this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        mpi::Z_gate(this->_data.qubit_map[target_qubit_index],
+            this->_data.data.data(), this->_data.data.size());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::apply_S(UINT target_qubit_index) {
+    check_out_of_range(
+        "target_qubit_index", target_qubit_index, 0U, this->_qubit_count);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::S_gate(
+            target_qubit_index, this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        mpi::S_gate(this->_data.qubit_map[target_qubit_index],
+            this->_data.data.data(), this->_data.data.size());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::apply_Sdag(UINT target_qubit_index) {
+    check_out_of_range(
+        "target_qubit_index", target_qubit_index, 0U, this->_qubit_count);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::Sdag_gate(
+            target_qubit_index, this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        mpi::Sdag_gate(this->_data.qubit_map[target_qubit_index],
+            this->_data.data.data(), this->_data.data.size());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::apply_T(UINT target_qubit_index) {
+    check_out_of_range(
+        "target_qubit_index", target_qubit_index, 0U, this->_qubit_count);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::T_gate(
+            target_qubit_index, this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        mpi::T_gate(this->_data.qubit_map[target_qubit_index],
+            this->_data.data.data(), this->_data.data.size());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::apply_Tdag(UINT target_qubit_index) {
+    check_out_of_range(
+        "target_qubit_index", target_qubit_index, 0U, this->_qubit_count);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::Tdag_gate(
+            target_qubit_index, this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        mpi::Tdag_gate(this->_data.qubit_map[target_qubit_index],
+            this->_data.data.data(), this->_data.data.size());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::apply_P0(UINT target_qubit_index) {
+    check_out_of_range(
+        "target_qubit_index", target_qubit_index, 0U, this->_qubit_count);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::P0_gate(
+            target_qubit_index, this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        mpi::P0_gate(this->_data.qubit_map[target_qubit_index],
+            this->_data.data.data(), this->_data.data.size());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::apply_P1(UINT target_qubit_index) {
+    check_out_of_range(
+        "target_qubit_index", target_qubit_index, 0U, this->_qubit_count);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::P1_gate(
+            target_qubit_index, this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        mpi::P1_gate(this->_data.qubit_map[target_qubit_index],
+            this->_data.data.data(), this->_data.data.size());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::apply_SWAP(
+    UINT target_qubit_index_0, UINT target_qubit_index_1) {
+    check_out_of_range(
+        "target_qubit_index_0", target_qubit_index_0, 0U, this->_qubit_count);
+    check_out_of_range(
+        "target_qubit_index_1", target_qubit_index_1, 0U, this->_qubit_count);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::SWAP_gate(target_qubit_index_0, target_qubit_index_1,
+            this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        // only the positions are exchanged. amplitudes move lazily when a
+        // later gate or set_qubit_map needs them elsewhere
+        std::swap(this->_data.qubit_map[target_qubit_index_0],
+            this->_data.qubit_map[target_qubit_index_1]);
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::set_qubit_map(const std::vector<UINT>& qubit_map) {
+    check_equal("qubit_map.size()", (UINT)qubit_map.size(), this->_qubit_count);
+    for (UINT qubit_index : qubit_map) {
+        check_out_of_range("qubit_index", qubit_index, 0U, this->_qubit_count);
+    }
+    check_no_duplicate("qubit_map", qubit_map);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        for (UINT i = 0; i < this->_qubit_count; ++i) {
+            if (qubit_map[i] != i) {
+                throw std::invalid_argument(
+                    "qubit_map must be the identity for DEFAULT.");
+            }
+        }
+    } else if constexpr (IMPL == MPI) {
+        std::vector<UINT>& current_map = this->_data.qubit_map;
+        std::vector<UINT> stored_qubit(this->_qubit_count);
+        for (UINT i = 0; i < this->_qubit_count; ++i) {
+            stored_qubit[current_map[i]] = i;
+        }
+        // each swap puts at least one qubit at its final position
+        for (UINT i = 0; i < this->_qubit_count; ++i) {
+            const UINT from = current_map[i];
+            const UINT to = qubit_map[i];
+            if (from == to) continue;
+            mpi::SWAP_gate(from, to, this->_data.data.data(),
+                this->_data.data.size());
+            const UINT displaced = stored_qubit[to];
+            current_map[displaced] = from;
+            stored_qubit[from] = displaced;
+            current_map[i] = to;
+            stored_qubit[to] = i;
+        }
     } else {
         assert(false);  // unknown IMPL. must be unreachable
     }
@@ -152,8 +708,14 @@ void StateVector<IMPL>::normalize(double squared_norm) {
 template <StateVectorImplementation IMPL>
 void StateVector<IMPL>::load(const std::vector<CTYPE>& state) {
     check_equal("state.size()", (ITYPE)state.size(), this->_dim);
-    if constexpr (IMPL == DEFAULT) {
-        this->_data.data = state;
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::load_quantum_state(
+            state.data(), this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        mpi::load_slab(state.data(), this->_data.data.data(),
+            this->_data.data.size());
+        std::iota(this->_data.qubit_map.begin(), this->_data.qubit_map.end(),
+            0U);
     } else {
         assert(false);  // unknown IMPL. must be unreachable
     }
@@ -163,7 +725,9 @@ template <StateVectorImplementation IMPL>
 void StateVector<IMPL>::load(std::vector<CTYPE>&& state) {
     check_equal("state.size()", (ITYPE)state.size(), this->_dim);
     if constexpr (IMPL == DEFAULT) {
-        this->_data.data = state;
+        this->_data.data.adopt(std::move(state));
+    } else if constexpr (IMPL == DEFAULT_F32 || IMPL == MPI) {
+        load(state);
     } else {
         assert(false);  // unknown IMPL. must be unreachable
     }
@@ -171,8 +735,46 @@ void StateVector<IMPL>::load(std::vector<CTYPE>&& state) {
 
 template <StateVectorImplementation IMPL>
 std::vector<CTYPE> StateVector<IMPL>::duplicate_data() const {
-    if constexpr (IMPL == DEFAULT) {
-        return this->_data.data;
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        return std::vector<CTYPE>(
+            this->_data.data.data(), this->_data.data.data() + this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        std::vector<CTYPE> state(this->_dim);
+        mpi::gather_slab(this->_data.data.data(), this->_data.data.size(),
+            state.data());
+        const std::vector<UINT>& qubit_map = this->_data.qubit_map;
+        if (std::is_sorted(qubit_map.begin(), qubit_map.end())) return state;
+        // qubit q of the result is the qubit stored at qubit_map[q]
+        std::vector<CTYPE> logical_state(this->_dim);
+        normal::permutate_qubit(
+            state.data(), logical_state.data(), qubit_map, this->_dim);
+        return logical_state;
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+void StateVector<IMPL>::wrap_external_data(value_type* state) {
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        this->_data.data.wrap(state, this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        this->_data.data.wrap(state, 1ULL << this->_data.inner_qc);
+        std::iota(this->_data.qubit_map.begin(), this->_data.qubit_map.end(),
+            0U);
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+AmplitudeView<typename StateVector<IMPL>::value_type>
+StateVector<IMPL>::get_amplitudes() const {
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        return AmplitudeView<value_type>(this->_data.data.data(), this->_dim);
+    } else if constexpr (IMPL == MPI) {
+        return AmplitudeView<value_type>(
+            this->_data.data.data(), this->_data.data.size());
     } else {
         assert(false);  // unknown IMPL. must be unreachable
     }
@@ -181,28 +783,271 @@ std::vector<CTYPE> StateVector<IMPL>::duplicate_data() const {
 template <StateVectorImplementation IMPL>
 std::vector<ITYPE> StateVector<IMPL>::sampling(
     UINT sampling_count, UINT seed) const {
-    if constexpr (IMPL == DEFAULT) {
-        std::vector<double> stacked_prob;
-        std::vector<ITYPE> result;
-        double sum = 0.;
-        stacked_prob.push_back(0.);
-        for (UINT i = 0; i < this->dim; ++i) {
-            sum += std::norm(this->_data.data[i]);
-            stacked_prob.push_back(sum);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        return normal::sampling(
+            this->_data.data.data(), this->_dim, sampling_count, seed);
+    } else if constexpr (IMPL == MPI) {
+        std::vector<ITYPE> samples = mpi::sampling(this->_data.data.data(),
+            this->_data.data.size(), sampling_count, seed);
+        for (ITYPE& sample : samples) {
+            sample = to_logical_basis(sample, this->_data.qubit_map);
+        }
+        return samples;
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+std::vector<ITYPE> StateVector<IMPL>::local_sampling(
+    UINT sampling_count, UINT seed) const {
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        return sampling(sampling_count, seed);
+    } else if constexpr (IMPL == MPI) {
+        std::vector<ITYPE> samples = mpi::local_sampling(
+            this->_data.data.data(), this->_data.data.size(), sampling_count,
+            seed);
+        for (ITYPE& sample : samples) {
+            sample = to_logical_basis(sample, this->_data.qubit_map);
+        }
+        return samples;
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+StateVector<IMPL> StateVector<IMPL>::relocated_copy(
+    const std::vector<UINT>& qubit_map) const {
+    StateVector<IMPL> state(this->_qubit_count, false);
+    if constexpr (IMPL == MPI) {
+        std::copy(this->_data.data.data(),
+            this->_data.data.data() + this->_data.data.size(),
+            state._data.data.data());
+        state._data.qubit_map = this->_data.qubit_map;
+        state.set_qubit_map(qubit_map);
+    } else {
+        assert(false);  // only MPI stores qubits elsewhere
+    }
+    return state;
+}
+
+template class StateVector<DEFAULT>;
+template class StateVector<DEFAULT_F32>;
+#ifdef _USE_MPI
+template class StateVector<MPI>;
+#endif
+
+namespace state {
+template <StateVectorImplementation IMPL>
+CTYPE inner_product(
+    const StateVector<IMPL>& state_bra, const StateVector<IMPL>& state_ket) {
+    check_equal("state_ket.qubit_count", state_ket.qubit_count,
+        state_bra.qubit_count);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        return normal::inner_product(state_bra.get_amplitudes().data(),
+            state_ket.get_amplitudes().data(), state_bra.dim);
+    } else if constexpr (IMPL == MPI) {
+        if (state_ket._data.qubit_map != state_bra._data.qubit_map) {
+            return inner_product(state_bra,
+                state_ket.relocated_copy(state_bra._data.qubit_map));
         }
+        return mpi::inner_product(state_bra.get_amplitudes().data(),
+            state_ket.get_amplitudes().data(),
+            state_bra.get_amplitudes().size());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+StateVector<IMPL> tensor_product(
+    const StateVector<IMPL>& state_left, const StateVector<IMPL>& state_right) {
+    StateVector<IMPL> state_out(
+        state_left.qubit_count + state_right.qubit_count, false);
+    tensor_product(state_left, state_right, state_out);
+    return state_out;
+}
+
+template <StateVectorImplementation IMPL>
+void tensor_product(const StateVector<IMPL>& state_left,
+    const StateVector<IMPL>& state_right, StateVector<IMPL>& state_out) {
+    check_equal("state_out.qubit_count", state_out.qubit_count,
+        state_left.qubit_count + state_right.qubit_count);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::tensor_product(state_left.get_amplitudes().data(),
+            state_left.dim, state_right.get_amplitudes().data(),
+            state_right.dim, state_out._data.data.data());
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+StateVector<IMPL> permutate_qubit(
+    const StateVector<IMPL>& state, const std::vector<UINT>& qubit_order) {
+    StateVector<IMPL> state_out(state.qubit_count, false);
+    permutate_qubit(state, qubit_order, state_out);
+    return state_out;
+}
+
+template <StateVectorImplementation IMPL>
+void permutate_qubit(const StateVector<IMPL>& state,
+    const std::vector<UINT>& qubit_order, StateVector<IMPL>& state_out) {
+    check_equal("qubit_order.size()", (UINT)qubit_order.size(),
+        state.qubit_count);
+    for (UINT qubit_index : qubit_order) {
+        check_out_of_range("qubit_index", qubit_index, 0U, state.qubit_count);
+    }
+    check_no_duplicate("qubit_order", qubit_order);
+    check_equal(
+        "state_out.qubit_count", state_out.qubit_count, state.qubit_count);
+    if (&state_out == &state) {
+        throw std::invalid_argument("state_out must differ from state.");
+    }
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::permutate_qubit(state.get_amplitudes().data(),
+            state_out._data.data.data(), qubit_order, state.dim);
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+StateVector<IMPL> drop_qubit(const StateVector<IMPL>& state,
+    const std::vector<UINT>& target, const std::vector<UINT>& projection) {
+    check_out_of_range(
+        "target.size()", (UINT)target.size(), 0U, state.qubit_count + 1);
+    StateVector<IMPL> state_out(state.qubit_count - target.size(), false);
+    drop_qubit(state, target, projection, state_out);
+    return state_out;
+}
 
-        Random random(seed);
-        for (UINT count = 0; count < sampling_count; ++count) {
-            double r = random.uniform();
-            auto ite =
-                std::lower_bound(stacked_prob.begin(), stacked_prob.end(), r);
-            auto index = std::distance(stacked_prob.begin(), ite) - 1;
-            result.push_back(index);
+template <StateVectorImplementation IMPL>
+void drop_qubit(const StateVector<IMPL>& state,
+    const std::vector<UINT>& target, const std::vector<UINT>& projection,
+    StateVector<IMPL>& state_out) {
+    check_equal(
+        "projection.size()", (UINT)projection.size(), (UINT)target.size());
+    for (UINT target_qubit_index : target) {
+        check_out_of_range(
+            "target_qubit_index", target_qubit_index, 0U, state.qubit_count);
+    }
+    check_no_duplicate("target", target);
+    check_equal("state_out.qubit_count", state_out.qubit_count,
+        state.qubit_count - (UINT)target.size());
+    std::vector<std::pair<UINT, UINT>> target_projection_list;
+    for (UINT i = 0; i < target.size(); ++i) {
+        check_out_of_range("projection", projection[i], 0U, 2U);
+        target_projection_list.emplace_back(target[i], projection[i]);
+    }
+    std::sort(target_projection_list.begin(), target_projection_list.end());
+    std::vector<UINT> sorted_target, sorted_projection;
+    for (const auto& [target_qubit_index, value] : target_projection_list) {
+        sorted_target.push_back(target_qubit_index);
+        sorted_projection.push_back(value);
+    }
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::drop_qubit(state.get_amplitudes().data(),
+            state_out._data.data.data(), sorted_target, sorted_projection,
+            state.dim);
+    } else {
+        assert(false);  // unknown IMPL. must be unreachable
+    }
+}
+
+template <StateVectorImplementation IMPL>
+StateVector<IMPL> make_superposition(CTYPE coef1,
+    const StateVector<IMPL>& state1, CTYPE coef2,
+    const StateVector<IMPL>& state2) {
+    StateVector<IMPL> state_out(state1.qubit_count, false);
+    make_superposition(coef1, state1, coef2, state2, state_out);
+    return state_out;
+}
+
+template <StateVectorImplementation IMPL>
+void make_superposition(CTYPE coef1, const StateVector<IMPL>& state1,
+    CTYPE coef2, const StateVector<IMPL>& state2,
+    StateVector<IMPL>& state_out) {
+    check_equal(
+        "state2.qubit_count", state2.qubit_count, state1.qubit_count);
+    check_equal(
+        "state_out.qubit_count", state_out.qubit_count, state1.qubit_count);
+    if constexpr (IMPL == DEFAULT || IMPL == DEFAULT_F32) {
+        normal::add_with_coef(coef1, state1.get_amplitudes().data(), coef2,
+            state2.get_amplitudes().data(), state_out._data.data.data(),
+            state1.dim);
+    } else if constexpr (IMPL == MPI) {
+        if (state2._data.qubit_map != state1._data.qubit_map) {
+            make_superposition(coef1, state1, coef2,
+                state2.relocated_copy(state1._data.qubit_map), state_out);
+            return;
         }
-        return result;
+        // each rank combines its own slab
+        normal::add_with_coef(coef1, state1.get_amplitudes().data(), coef2,
+            state2.get_amplitudes().data(), state_out._data.data.data(),
+            state1.get_amplitudes().size());
+        state_out._data.qubit_map = state1._data.qubit_map;
     } else {
         assert(false);  // unknown IMPL. must be unreachable
     }
 }
 
-template class StateVector<DEFAULT>;
\ No newline at end of file
+template CTYPE inner_product(const StateVector<DEFAULT>& state_bra,
+    const StateVector<DEFAULT>& state_ket);
+template CTYPE inner_product(const StateVector<DEFAULT_F32>& state_bra,
+    const StateVector<DEFAULT_F32>& state_ket);
+template StateVector<DEFAULT> tensor_product(
+    const StateVector<DEFAULT>& state_left,
+    const StateVector<DEFAULT>& state_right);
+template StateVector<DEFAULT_F32> tensor_product(
+    const StateVector<DEFAULT_F32>& state_left,
+    const StateVector<DEFAULT_F32>& state_right);
+template void tensor_product(const StateVector<DEFAULT>& state_left,
+    const StateVector<DEFAULT>& state_right, StateVector<DEFAULT>& state_out);
+template void tensor_product(const StateVector<DEFAULT_F32>& state_left,
+    const StateVector<DEFAULT_F32>& state_right,
+    StateVector<DEFAULT_F32>& state_out);
+template StateVector<DEFAULT> permutate_qubit(
+    const StateVector<DEFAULT>& state, const std::vector<UINT>& qubit_order);
+template StateVector<DEFAULT_F32> permutate_qubit(
+    const StateVector<DEFAULT_F32>& state,
+    const std::vector<UINT>& qubit_order);
+template void permutate_qubit(const StateVector<DEFAULT>& state,
+    const std::vector<UINT>& qubit_order, StateVector<DEFAULT>& state_out);
+template void permutate_qubit(const StateVector<DEFAULT_F32>& state,
+    const std::vector<UINT>& qubit_order, StateVector<DEFAULT_F32>& state_out);
+template StateVector<DEFAULT> drop_qubit(const StateVector<DEFAULT>& state,
+    const std::vector<UINT>& target, const std::vector<UINT>& projection);
+template StateVector<DEFAULT_F32> drop_qubit(
+    const StateVector<DEFAULT_F32>& state, const std::vector<UINT>& target,
+    const std::vector<UINT>& projection);
+template void drop_qubit(const StateVector<DEFAULT>& state,
+    const std::vector<UINT>& target, const std::vector<UINT>& projection,
+    StateVector<DEFAULT>& state_out);
+template void drop_qubit(const StateVector<DEFAULT_F32>& state,
+    const std::vector<UINT>& target, const std::vector<UINT>& projection,
+    StateVector<DEFAULT_F32>& state_out);
+template StateVector<DEFAULT> make_superposition(CTYPE coef1,
+    const StateVector<DEFAULT>& state1, CTYPE coef2,
+    const StateVector<DEFAULT>& state2);
+template StateVector<DEFAULT_F32> make_superposition(CTYPE coef1,
+    const StateVector<DEFAULT_F32>& state1, CTYPE coef2,
+    const StateVector<DEFAULT_F32>& state2);
+template void make_superposition(CTYPE coef1,
+    const StateVector<DEFAULT>& state1, CTYPE coef2,
+    const StateVector<DEFAULT>& state2, StateVector<DEFAULT>& state_out);
+template void make_superposition(CTYPE coef1,
+    const StateVector<DEFAULT_F32>& state1, CTYPE coef2,
+    const StateVector<DEFAULT_F32>& state2,
+    StateVector<DEFAULT_F32>& state_out);
+#ifdef _USE_MPI
+template CTYPE inner_product(
+    const StateVector<MPI>& state_bra, const StateVector<MPI>& state_ket);
+template StateVector<MPI> make_superposition(CTYPE coef1,
+    const StateVector<MPI>& state1, CTYPE coef2,
+    const StateVector<MPI>& state2);
+template void make_superposition(CTYPE coef1, const StateVector<MPI>& state1,
+    CTYPE coef2, const StateVector<MPI>& state2, StateVector<MPI>& state_out);
+#endif
+}  // namespace state
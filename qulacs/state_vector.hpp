@@ -6,12 +6,27 @@
 #pragma once
 #include <vector>
 
+#include "internal/general/amplitude_storage.hpp"
 #include "internal/general/type.hpp"
 
 /**
  * @brief type of StateVector Implementation
+ *
+ * DEFAULT_F32 stores amplitudes in single precision. Gate matrices and
+ * results of reductions stay in double precision.
+ *
+ * MPI distributes amplitudes over the largest power of 2 of the ranks of
+ * MPI_COMM_WORLD, taken evenly from the nodes. Active rank r holds the
+ * amplitudes whose upper log2(size) bits are r, and the other ranks must
+ * not create StateVector<MPI> (see StateVector::get_layout). It needs a
+ * build with USE_MPI and MPI_Init by the caller, and every active rank must
+ * call the same methods in the same order.
+ * Gates on the upper qubits exchange amplitudes in chunks of
+ * 2^QULACS_MPI_WORK_NQUBIT, with QULACS_MPI_PIPELINE_DEPTH chunks in flight.
+ * The position where each qubit is stored can differ from its index (see
+ * StateVector::set_qubit_map), which is invisible except for raw amplitudes.
  */
-enum class StateVectorImplementation { DEFAULT, MPI };
+enum class StateVectorImplementation { DEFAULT, DEFAULT_F32, MPI };
 
 /**
  * @brief StateVector Data Structure
@@ -19,17 +34,154 @@ enum class StateVectorImplementation { DEFAULT, MPI };
 template <StateVectorImplementation IMPL>
 struct StateVectorData {};
 
+class Circuit;
+
+template <>
+struct StateVectorData<StateVectorImplementation::DEFAULT> {
+    using value_type = CTYPE;
+    AmplitudeStorage<CTYPE> data;
+
+    StateVectorData(UINT qubit_count) : data(1ULL << qubit_count) {}
+};
+
+template <>
+struct StateVectorData<StateVectorImplementation::DEFAULT_F32> {
+    using value_type = CTYPE_F32;
+    AmplitudeStorage<CTYPE_F32> data;
+
+    StateVectorData(UINT qubit_count) : data(1ULL << qubit_count) {}
+};
+
+template <>
+struct StateVectorData<StateVectorImplementation::MPI> {
+    using value_type = CTYPE;
+    //! number of qubits distributed over ranks
+    UINT outer_qc;
+    //! number of qubits held by each rank
+    UINT inner_qc;
+    //! amplitudes held by this rank
+    AmplitudeStorage<CTYPE> data;
+    //! qubit q is stored at bit qubit_map[q] of the distributed index
+    std::vector<UINT> qubit_map;
+
+    StateVectorData(UINT qubit_count);
+};
+
+template <StateVectorImplementation IMPL>
+class StateVector;
+
+namespace state {
+template <StateVectorImplementation IMPL>
+CTYPE DllExport inner_product(
+    const StateVector<IMPL>& state_bra, const StateVector<IMPL>& state_ket);
+template <StateVectorImplementation IMPL>
+DllExport void tensor_product(const StateVector<IMPL>& state_left,
+    const StateVector<IMPL>& state_right, StateVector<IMPL>& state_out);
+template <StateVectorImplementation IMPL>
+DllExport void make_superposition(CTYPE coef1,
+    const StateVector<IMPL>& state1, CTYPE coef2,
+    const StateVector<IMPL>& state2, StateVector<IMPL>& state_out);
+template <StateVectorImplementation IMPL>
+DllExport void permutate_qubit(const StateVector<IMPL>& state,
+    const std::vector<UINT>& qubit_order, StateVector<IMPL>& state_out);
+template <StateVectorImplementation IMPL>
+DllExport void drop_qubit(const StateVector<IMPL>& state,
+    const std::vector<UINT>& target, const std::vector<UINT>& projection,
+    StateVector<IMPL>& state_out);
+}  // namespace state
+
+/**
+ * @brief statistics to compute by StateVector::get_statistics
+ * \~japanese-en StateVector::get_statisticsで計算する統計量の指定
+ */
+struct StatisticsRequest {
+    //! エントロピーを計算するか
+    bool entropy = false;
+    //! 全ての量子ビットについて0が観測される確率を計算するか
+    bool zero_probabilities = false;
+    //! 周辺確率のリスト。各要素はget_marginal_probabilityの引数と同じ形式
+    std::vector<std::vector<UINT>> marginal_list;
+};
+
+/**
+ * @brief result of StateVector::get_statistics
+ * \~japanese-en StateVector::get_statisticsの結果
+ */
+struct Statistics {
+    //! ノルムの2乗。常に計算される
+    double squared_norm = 0.;
+    //! エントロピー
+    double entropy = 0.;
+    //! i番目の量子ビットで0が観測される確率
+    std::vector<double> zero_probabilities;
+    //! marginal_listの各要素に対応する周辺確率
+    std::vector<double> marginal_probabilities;
+};
+
+/**
+ * @brief placement of StateVector over processes, returned by
+ * StateVector::get_layout
+ * \~japanese-en StateVectorのプロセスへの配置。StateVector::get_layoutの結果
+ */
+struct StateVectorLayout {
+    //! MPI_COMM_WORLDのランク数
+    UINT world_size = 1;
+    //! MPI_COMM_WORLDでの自身のランク
+    UINT world_rank = 0;
+    //! 状態ベクトルを分担するランク(アクティブランク)の数。2のべき乗
+    UINT active_size = 1;
+    //! 自身がアクティブランクか
+    bool active = true;
+    //! アクティブランクでの自身の番号。上位ビットがこの値の振幅を持つ
+    UINT active_rank = 0;
+    //! メモリを共有できるランクのまとまり(ノード)の数
+    UINT node_count = 1;
+    //! 自身のノードの番号
+    UINT node_index = 0;
+    //! 自身のノードのランク数
+    UINT node_size = 1;
+    //! 自身のノードのアクティブランクの数
+    UINT node_active_size = 1;
+    //! 各ランクでカーネルが使うOpenMPのスレッド数。USE_OMP=OFFのビルドでは1
+    UINT thread_count = 1;
+};
+
 /**
  * @brief StateVector expression of quantum state
  * \~japanese-en 量子状態の状態ベクトルによる表現
  */
 template <StateVectorImplementation IMPL>
 class StateVector {
+public:
+    //! type of an amplitude
+    using value_type = typename StateVectorData<IMPL>::value_type;
+
 private:
     UINT _qubit_count;
     ITYPE _dim;
     StateVectorData<IMPL> _data;
 
+    //! copy of this state stored with <code>qubit_map</code> (MPI only)
+    StateVector relocated_copy(const std::vector<UINT>& qubit_map) const;
+
+    //! project to the bases with <code>basis & mask == value</code> and
+    //! normalize, where <code>probability</code> is their squared norm
+    void project_and_normalize(ITYPE mask, ITYPE value, double probability);
+
+    friend class Circuit;
+    friend CTYPE state::inner_product<IMPL>(
+        const StateVector& state_bra, const StateVector& state_ket);
+    friend void state::tensor_product<IMPL>(const StateVector& state_left,
+        const StateVector& state_right, StateVector& state_out);
+    friend void state::make_superposition<IMPL>(CTYPE coef1,
+        const StateVector& state1, CTYPE coef2, const StateVector& state2,
+        StateVector& state_out);
+    friend void state::permutate_qubit<IMPL>(const StateVector& state,
+        const std::vector<UINT>& qubit_order, StateVector& state_out);
+    friend void state::drop_qubit<IMPL>(const StateVector& state,
+        const std::vector<UINT>& target, const std::vector<UINT>& projection,
+        StateVector& state_out);
+
 public:
     /**
      * @brief num of qubits
@@ -52,9 +204,38 @@ public:
     /**
      * @brief constructor
      * \~japanese-en コンストラクタ
+     *
+     * <code>initialize</code>がfalseの場合、振幅は初期化されない。
+     * set_zero_state、set_Haar_random_state、loadなどで値を設定してから使うこと。
+     * 初期化の書き込みを一度で済ませ、ページの配置も初期化関数の並列化に従う。
      * @param qubit_count num of qubits
+     * @param initialize ノルム0の状態に初期化するか
+     */
+    StateVector(UINT qubit_count_, bool initialize = true);
+
+    /**
+     * @brief move constructor
+     * \~japanese-en ムーブコンストラクタ
+     *
+     * 振幅の配列はコピーせずに引き継ぐ。
      */
-    StateVector(UINT qubit_count_);
+    StateVector(StateVector&& other);
+
+    /**
+     * @brief get placement over processes
+     * \~japanese-en 状態ベクトルのプロセスへの配置を得る
+     *
+     * MPIではランク数が2のべき乗でない場合、その数以下で最大の2のべき乗個のランクが
+     * 状態ベクトルを分担する。各ノードから順に1ランクずつ選ぶのでノード間で偏らない。
+     * 各ノードのランクは2のべき乗個ずつのブロックに分け、大きいブロックから番号を付ける。
+     * 2^k個のランクのブロックでは、下位k個の外側の量子ビットのペアがノード内に収まる。
+     * activeがfalseのランクでStateVector<MPI>を作ると例外を送出する。
+     * USE_OMP=ONでビルドした場合、ノードあたり1ランクとしてOpenMPのスレッドで
+     * ノード内を並列化する構成も、ここで確認できる。
+     * DEFAULT、DEFAULT_F32では1プロセスの配置を返す。
+     * @return 配置
+     */
+    static StateVectorLayout get_layout();
 
     /**
      * @brief intialize state to computational basis "0"
@@ -77,7 +258,7 @@ public:
      * @brief initialize state to Haar random state
      * \~japanese-en 量子状態をHaar
      * randomにサンプリングされた量子状態に初期化する
-     * @param seed シード値
+     * @param seed シード値。MPIではランク0の値を全ランクで使う
      */
     void set_Haar_random_state(UINT seed = (UINT)time(nullptr));
 
@@ -92,6 +273,16 @@ public:
      */
     double get_zero_probability(UINT target_qubit_index) const;
 
+    /**
+     * @brief calculate probability of observing zero on each qubit
+     * \~japanese-en 各量子ビットを測定した時、0が観測される確率を計算する。
+     *
+     * get_zero_probabilityを全ての量子ビットについて呼ぶのと同じ結果を、
+     * 状態ベクトルの一度の走査で計算する。
+     * @return i番目の要素がi番目の量子ビットで0が観測される確率である配列
+     */
+    std::vector<double> get_zero_probabilities() const;
+
     /**
      * @brief calculate probability of observing specified computational basis
      * \~japanese-en 複数の量子ビットを測定した時の周辺確率を計算する
@@ -103,6 +294,18 @@ public:
     double get_marginal_probability(
         const std::vector<UINT>& measured_values) const;
 
+    /**
+     * @brief calculate distribution of outcomes on specified qubits
+     * \~japanese-en 複数の量子ビットを測定した時の測定結果の分布を計算する
+     *
+     * 状態ベクトルの一度の走査で、全ての測定結果の周辺確率を計算する。
+     * @param target_qubit_index_list 測定する量子ビットの添え字のリスト
+     * @return 長さ2^kの配列。添え字のi番目のビットが
+     * <code>target_qubit_index_list[i]</code>の測定結果を表す。
+     */
+    std::vector<double> get_marginal_distribution(
+        const std::vector<UINT>& target_qubit_index_list) const;
+
     /**
      * @brief calculate entropy of probability distribution
      * \~japanese-en
@@ -112,6 +315,17 @@ public:
      */
     double get_entropy() const;
 
+    /**
+     * @brief calculate multiple statistics in one sweep
+     * \~japanese-en 複数の統計量を状態ベクトルの一度の走査で計算する
+     *
+     * ノルム、エントロピー、各量子ビットの0の確率、周辺確率を個別に計算すると
+     * それぞれが状態ベクトル全体を走査するが、この関数は一度で済ませる。
+     * @param request 計算する統計量
+     * @return 計算された統計量
+     */
+    Statistics get_statistics(const StatisticsRequest& request) const;
+
     /**
      * @brief calculate norm
      * \~japanese-en 量子状態のノルムを計算する
@@ -129,6 +343,163 @@ public:
      */
     void normalize(double squared_norm);
 
+    /**
+     * @brief project to specified values of qubits and normalize
+     * \~japanese-en 量子ビットの値への射影を行い、正規化する
+     *
+     * 射影した状態のノルムを求めた後、射影と正規化を一度の走査で行う。
+     * 射影後のノルムが0の場合は量子状態を変更せずに例外を送出する。
+     * @param target_qubit_index_list 射影する量子ビットのインデックスのリスト
+     * @param projection_list 射影先の値(0または1)のリスト
+     * @return 射影後の状態が観測される確率
+     */
+    double apply_projection(const std::vector<UINT>& target_qubit_index_list,
+        const std::vector<UINT>& projection_list);
+
+    /**
+     * @brief measure qubit and collapse state
+     * \~japanese-en 量子ビットを測定し、測定結果に応じて量子状態を収縮させる
+     *
+     * 0が観測される確率を求める走査と、射影と正規化を行う走査の2回で済む。
+     * @param target_qubit_index 測定する量子ビットのインデックス
+     * @param seed 測定結果を決める乱数のシード値。MPIではランク0の値を全ランクで使う
+     * @return 測定結果(0または1)
+     */
+    UINT measure(UINT target_qubit_index, UINT seed = (UINT)time(nullptr));
+
+    /**
+     * @brief apply single qubit dense matrix
+     * \~japanese-en 1量子ビットに2x2の密行列を作用させる
+     *
+     * @param target_qubit_index 作用する量子ビットのインデックス
+     * @param matrix 行優先で並べた2x2行列
+     */
+    void apply_single_qubit_dense_matrix(
+        UINT target_qubit_index, const CTYPE matrix[4]);
+
+    /**
+     * @brief apply multi qubit dense matrix with control qubits
+     * \~japanese-en 制御量子ビット付きで複数量子ビットに密行列を作用させる
+     *
+     * 行列の添え字のiビット目は<code>target_qubit_index_list[i]</code>に対応する。
+     * @param target_qubit_index_list 作用する量子ビットのインデックスのリスト
+     * @param matrix 行優先で並べた2^k x 2^k行列
+     * @param control_qubit_index_list 制御量子ビットのインデックスのリスト
+     * @param control_value_list 制御量子ビットの値(0または1)のリスト
+     */
+    void apply_multi_qubit_dense_matrix(
+        const std::vector<UINT>& target_qubit_index_list,
+        const std::vector<CTYPE>& matrix,
+        const std::vector<UINT>& control_qubit_index_list = {},
+        const std::vector<UINT>& control_value_list = {});
+
+    /**
+     * @brief apply single qubit diagonal matrix
+     * \~japanese-en 1量子ビットに対角行列を作用させる
+     *
+     * @param target_qubit_index 作用する量子ビットのインデックス
+     * @param diagonal_matrix 対角成分
+     */
+    void apply_single_qubit_diagonal_matrix(
+        UINT target_qubit_index, const CTYPE diagonal_matrix[2]);
+
+    /**
+     * @brief apply phase to the amplitudes whose target bit is 1
+     * \~japanese-en 対象の量子ビットが1である振幅に位相を掛ける
+     *
+     * @param target_qubit_index 作用する量子ビットのインデックス
+     * @param phase 掛ける位相
+     */
+    void apply_single_qubit_phase(UINT target_qubit_index, CTYPE phase);
+
+    /**
+     * @brief apply RZ gate exp(-i angle Z / 2)
+     * \~japanese-en RZゲート exp(-i angle Z / 2) を作用させる
+     *
+     * @param target_qubit_index 作用する量子ビットのインデックス
+     * @param angle 回転角
+     */
+    void apply_RZ(UINT target_qubit_index, double angle);
+
+    /**
+     * @brief apply Pauli-X gate
+     * \~japanese-en Pauli-Xゲートを作用させる
+     */
+    void apply_X(UINT target_qubit_index);
+
+    /**
+     * @brief apply Pauli-Y gate
+     * \~japanese-en Pauli-Yゲートを作用させる
+     */
+    void apply_Y(UINT target_qubit_index);
+
+    /**
+     * @brief apply Pauli-Z gate
+     * \~japanese-en Pauli-Zゲートを作用させる
+     */
+    void apply_Z(UINT target_qubit_index);
+
+    /**
+     * @brief apply S gate
+     * \~japanese-en Sゲートを作用させる
+     */
+    void apply_S(UINT target_qubit_index);
+
+    /**
+     * @brief apply Sdag gate
+     * \~japanese-en Sdagゲートを作用させる
+     */
+    void apply_Sdag(UINT target_qubit_index);
+
+    /**
+     * @brief apply T gate
+     * \~japanese-en Tゲートを作用させる
+     */
+    void apply_T(UINT target_qubit_index);
+
+    /**
+     * @brief apply Tdag gate
+     * \~japanese-en Tdagゲートを作用させる
+     */
+    void apply_Tdag(UINT target_qubit_index);
+
+    /**
+     * @brief apply projection to 0
+     * \~japanese-en 0への射影を作用させる
+     */
+    void apply_P0(UINT target_qubit_index);
+
+    /**
+     * @brief apply projection to 1
+     * \~japanese-en 1への射影を作用させる
+     */
+    void apply_P1(UINT target_qubit_index);
+
+    /**
+     * @brief swap two qubits in place
+     * \~japanese-en 2つの量子ビットを入れ替える
+     *
+     * 状態ベクトルの上で直接入れ替えるので、追加の状態ベクトル分のメモリを必要としない。
+     * @param target_qubit_index_0 入れ替える量子ビットのインデックス
+     * @param target_qubit_index_1 入れ替える量子ビットのインデックス
+     */
+    void apply_SWAP(UINT target_qubit_index_0, UINT target_qubit_index_1);
+
+    /**
+     * @brief relocate qubits without changing the state
+     * \~japanese-en 量子状態を変えずに量子ビットの格納位置を変更する
+     *
+     * MPIでは上位の量子ビットがランク間に分散しており、それらへのゲートは通信を伴う。
+     * q番目の量子ビットを<code>qubit_map[q]</code>番目の位置に移し、
+     * data.qubit_mapを更新する。格納位置は他の関数の結果に影響しないが、
+     * get_amplitudesのビューは格納位置の順となる。
+     * Circuit::update_quantum_stateは通信が減るように格納位置を自動で変更し、
+     * MPIのapply_SWAPは振幅を動かさずに格納位置の対応のみを入れ替える。
+     * DEFAULT、DEFAULT_F32では恒等写像のみ受け付ける。
+     * @param qubit_map 各量子ビットの格納位置
+     */
+    void set_qubit_map(const std::vector<UINT>& qubit_map);
+
     /**
      * @brief copy std::vector to this
      * \~japanese-en <code>state</code>の量子状態を自身へコピーする。
@@ -137,15 +508,43 @@ public:
     void load(const std::vector<CTYPE>& state);
 
     /**
-     * @brief copy std::vector to this
+     * @brief move std::vector to this
      * \~japanese-en <code>state</code>の量子状態を自身へムーブする。
+     *
+     * DEFAULTではコピーせずに<code>state</code>のバッファを引き継ぐ。
+     * DEFAULT_F32では単精度に変換してコピーする。
      * @param state ムーブ元
      */
     void load(std::vector<CTYPE>&& state);
 
+    /**
+     * @brief refer to external buffer without copying
+     * \~japanese-en 外部のバッファをコピーせずに量子状態として参照する
+     *
+     * 所有権は呼び出し側に残る。バッファはdim個の振幅を持ち、
+     * このStateVectorより長く生存しなければならない。
+     * MPIではバッファは自身のランクが持つ振幅の分だけでよく、
+     * 量子ビットの格納位置は元の順序に戻る。
+     * @param state 振幅の配列の先頭
+     */
+    void wrap_external_data(value_type* state);
+
+    /**
+     * @brief get read-only view of amplitudes without copying
+     * \~japanese-en 振幅をコピーせずに読み取り専用のビューとして得る
+     *
+     * ビューはこのStateVectorの次のload、wrap_external_dataまで有効。
+     * MPIでは自身のランクが持つ振幅のみのビューとなり、
+     * 添え字は量子ビットの格納位置(data.qubit_map)に従う。
+     * @return 振幅のビュー
+     */
+    AmplitudeView<value_type> get_amplitudes() const;
+
     /**
      * @brief get copied state vector
      * \~japanese-en 量子状態のコピーををstd::vector<CTYPE>として得る
+     *
+     * MPIでは全てのランクの振幅を集めるので、全体が1プロセスに収まる場合のみ使うこと。
      * @return 量子状態のコピー
      */
     std::vector<CTYPE> duplicate_data() const;
@@ -155,11 +554,28 @@ public:
      * \~japanese-en 量子状態を測定した際の計算基底のサンプリングを行う
      *
      * @param[in] sampling_count サンプリングを行う回数
-     * @param[in] seed サンプリングで乱数を振るシード値
+     * @param[in] seed サンプリングで乱数を振るシード値。MPIではランク0の値を全ランクで使う
      * @return サンプルされた値のリスト
      */
     std::vector<ITYPE> sampling(
         UINT sampling_count, UINT seed = (UINT)time(nullptr)) const;
+
+    /**
+     * @brief do sampling, returning only the samples held by this process
+     * \~japanese-en 自身のプロセスが持つ振幅から得たサンプルのみを返すサンプリングを行う
+     *
+     * MPIでは各ランクのノルムを集めて全ランクで同じようにショット数を振り分け、
+     * 各ランクが自身の振幅から振り分けられた分だけサンプリングする。
+     * 状態ベクトルや全サンプルを1ランクに集めないので、
+     * 全体が1プロセスに収まらない場合にも使える。
+     * 全ランクの結果を合わせるとsamplingと同じ分布に従う<code>sampling_count</code>個のサンプルとなる。
+     * DEFAULT、DEFAULT_F32ではsamplingと同じ。
+     * @param[in] sampling_count 全ランクで合わせたサンプリングの回数
+     * @param[in] seed サンプリングで乱数を振るシード値。MPIではランク0の値を全ランクで使う
+     * @return 自身のランクでサンプルされた値のリスト
+     */
+    std::vector<ITYPE> local_sampling(
+        UINT sampling_count, UINT seed = (UINT)time(nullptr)) const;
 };
 
 namespace state {
@@ -187,10 +603,27 @@ template <StateVectorImplementation IMPL>
 DllExport StateVector<IMPL> tensor_product(
     const StateVector<IMPL>& state_left, const StateVector<IMPL>& state_right);
 
+/**
+ * @brief calculate tensor product of two StateVector into existing state
+ * \~japanese-en 量子状態間のテンソル積を既存の量子状態に書き込む
+ *
+ * @param[in] state_left 上位ビット側の量子状態
+ * @param[in] state_right 下位ビット側の量子状態
+ * @param[out] state_out
+ * テンソル積を書き込む量子状態。量子ビット数は2つの量子状態の和と等しいこと
+ */
+template <StateVectorImplementation IMPL>
+DllExport void tensor_product(const StateVector<IMPL>& state_left,
+    const StateVector<IMPL>& state_right, StateVector<IMPL>& state_out);
+
 /**
  * @brief permutate qubit index
  * \~japanese-en 量子ビットの順番を入れ替えた量子状態を返す
  *
+ * 変換後の量子状態のq番目の量子ビットは、変換前の量子状態の
+ * <code>qubit_order[q]</code>番目の量子ビットになる。
+ * 新たな状態ベクトルを確保するので、メモリが足りない場合は
+ * StateVector::apply_SWAPを繰り返して入れ替えること。
  * @param[in] state 変換前の量子状態
  * @param[in] qubit_order 量子ビット入れ替えの順列
  * @return 変換後の量子状態
@@ -200,10 +633,24 @@ DllExport StateVector<IMPL> permutate_qubit(
     const StateVector<IMPL>& state, const std::vector<UINT>& qubit_order);
 
 /**
- * @brief permutate qubit index
- * \~japanese-en 特定の量子ビットへの射影を行う
+ * @brief permutate qubit index into existing state
+ * \~japanese-en 量子ビットの順番を入れ替えた量子状態を既存の量子状態に書き込む
  *
  * @param[in] state 変換前の量子状態
+ * @param[in] qubit_order 量子ビット入れ替えの順列
+ * @param[out] state_out
+ * 変換後の量子状態を書き込む量子状態。<code>state</code>とは別の量子状態であること
+ */
+template <StateVectorImplementation IMPL>
+DllExport void permutate_qubit(const StateVector<IMPL>& state,
+    const std::vector<UINT>& qubit_order, StateVector<IMPL>& state_out);
+
+/**
+ * @brief project and remove qubits
+ * \~japanese-en 特定の量子ビットへの射影を行い、その量子ビットを取り除く
+ *
+ * 残りの量子ビットは元の順序のまま詰める。結果は正規化しない。
+ * @param[in] state 変換前の量子状態
  * @param[in] target 射影対象の量子ビットインデックス
  * @param[in] projection 射影先(0または1)
  * @return 変換後の量子状態
@@ -212,6 +659,21 @@ template <StateVectorImplementation IMPL>
 DllExport StateVector<IMPL> drop_qubit(const StateVector<IMPL>& state,
     const std::vector<UINT>& target, const std::vector<UINT>& projection);
 
+/**
+ * @brief project and remove qubits into existing state
+ * \~japanese-en 射影を行い量子ビットを取り除いた量子状態を既存の量子状態に書き込む
+ *
+ * @param[in] state 変換前の量子状態
+ * @param[in] target 射影対象の量子ビットインデックス
+ * @param[in] projection 射影先(0または1)
+ * @param[out] state_out
+ * 変換後の量子状態を書き込む量子状態。量子ビット数はstateより射影対象の数だけ少ないこと
+ */
+template <StateVectorImplementation IMPL>
+DllExport void drop_qubit(const StateVector<IMPL>& state,
+    const std::vector<UINT>& target, const std::vector<UINT>& projection,
+    StateVector<IMPL>& state_out);
+
 /**
  * @brief create superposition of states of coef1|state1>+coef2|state2>
  * \japanese-en 2量子状態の係数付き重ね合わせ状態を作成する
@@ -225,4 +687,21 @@ template <StateVectorImplementation IMPL>
 DllExport StateVector<IMPL> make_superposition(CTYPE coef1,
     const StateVector<IMPL>& state1, CTYPE coef2,
     const StateVector<IMPL>& state2);
+
+/**
+ * @brief write superposition of states of coef1|state1>+coef2|state2> into
+ * existing state
+ * \~japanese-en 2量子状態の係数付き重ね合わせ状態を既存の量子状態に書き込む
+ *
+ * <code>state_out</code>はstate1またはstate2と同じでもよい。
+ * @param[in] coef1 state1の係数
+ * @param[in] state1 1つ目の量子状態
+ * @param[in] coef2 state2の係数
+ * @param[in] state2 2つ目の量子状態
+ * @param[out] state_out 重ね合わせ状態を書き込む量子状態
+ */
+template <StateVectorImplementation IMPL>
+DllExport void make_superposition(CTYPE coef1,
+    const StateVector<IMPL>& state1, CTYPE coef2,
+    const StateVector<IMPL>& state2, StateVector<IMPL>& state_out);
 }  // namespace state
@@ -0,0 +1,10 @@
+#!/bin/sh
+set -eux
+
+mkdir -p ./build
+cd ./build
+cmake -G Ninja -DBUILD_BENCHMARK=ON -DUSE_OMP=ON -DCMAKE_BUILD_TYPE=Release ..
+ninja -j $(nproc) qulacs_bench
+cd ..
+./bin/qulacs_bench --benchmark_out=bench_output.json \
+    --benchmark_out_format=json "$@"